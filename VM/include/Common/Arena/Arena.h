@@ -0,0 +1,87 @@
+#ifndef ARENA_ARENA_H
+#define ARENA_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump-pointer allocator: memory is carved out of large blocks and released
+// all at once with the arena. Objects with non-trivial destructors are
+// finalized on destruction, newest first.
+class Arena
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64 << 10;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+
+    void* allocate(size_t size, size_t align);
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args);
+
+private:
+    struct Finalizer
+    {
+        Finalizer* next;
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::byte* cur_ = nullptr;
+    std::byte* end_ = nullptr;
+    Finalizer* finalizers_ = nullptr;
+};
+
+inline Arena::~Arena()
+{
+    for (Finalizer* fin = finalizers_; fin; fin = fin->next)
+    {
+        fin->destroy(fin->object);
+    }
+}
+
+inline void* Arena::allocate(size_t size, size_t align)
+{
+    void* ptr = cur_;
+    size_t space = static_cast<size_t>(end_ - cur_);
+    if (!std::align(align, size, ptr, space))
+    {
+        size_t block_size = std::max(BLOCK_SIZE, size + align);
+        blocks_.emplace_back(new std::byte[block_size]);
+
+        cur_ = blocks_.back().get();
+        end_ = cur_ + block_size;
+        ptr = cur_;
+        space = block_size;
+        std::align(align, size, ptr, space);
+    }
+
+    cur_ = static_cast<std::byte*>(ptr) + size;
+    return ptr;
+}
+
+template<typename T, typename... Args>
+T* Arena::create(Args&&... args)
+{
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        auto* fin = new (allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer;
+        fin->next = finalizers_;
+        fin->object = object;
+        fin->destroy = [](void* obj) { static_cast<T*>(obj)->~T(); };
+        finalizers_ = fin;
+    }
+    return object;
+}
+
+#endif // ARENA_ARENA_H
@@ -33,6 +33,12 @@ enum class MethodType
     NATIVE,
 };
 
+enum class FieldType
+{
+    INSTANCE,
+    STATIC,
+};
+
 enum class VariableType
 {
     VOID,
@@ -47,6 +53,22 @@ enum class VariableType
     REFERENCE,
 };
 
+// Narrow ints are widened to INT on the operand stack and in local slots.
+inline VariableType stackType(VariableType var_type)
+{
+    switch (var_type)
+    {
+    case VariableType::BOOLEAN:
+    case VariableType::BYTE:
+    case VariableType::CHAR:
+    case VariableType::SHORT:
+        return VariableType::INT;
+    default:
+        break;
+    }
+    return var_type;
+}
+
 enum class OperationType
 {
     OR,
@@ -66,6 +88,7 @@ enum class OperationType
     SQR_BR,
     NEW,
     RETURN,
+    SHL,
 };
 
 enum class ControlType
@@ -69,7 +69,7 @@ void Tree<T>::push_branch(const Tree& tree)
 template<typename T>
 void Tree<T>::emplace_branch(Tree&& tree)
 {
-    branches_.emplace_back(tree);
+    branches_.emplace_back(std::move(tree));
 }
 
 template<typename T>
@@ -27,9 +27,10 @@ struct FieldNode : public ASNode
 {
     std::string name;
     AccessType access_type;
+    FieldType modifier;
     VariableType var_type;
 
-    FieldNode(std::string name_, AccessType access_type_, VariableType var_type_);
+    FieldNode(std::string name_, AccessType access_type_, FieldType modifier_, VariableType var_type_);
     NodeType type() const override;
     std::string print() const override;
 };
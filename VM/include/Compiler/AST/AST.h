@@ -1,21 +1,90 @@
 #ifndef COMPILER_AST_AST_H
 #define COMPILER_AST_AST_H
 
-#include "Tree/Tree-impl.h"
+#include "Arena/Arena.h"
 #include "Compiler/AST/ASNode.h"
 
-#include <memory>
+#include <cstdint>
+#include <fstream>
+#include <vector>
 
-class AST : public Tree<std::shared_ptr<ASNode>>
+class AST;
+
+class ASTRef
 {
 public:
-    AST() = default;
-    explicit AST(std::shared_ptr<ASNode> value);
+    ASTRef(const AST* ast, uint32_t id);
+
+    ASTRef operator[](size_t branch_ind) const;
+    size_t branches_num() const;
+    ASNode* value() const;
+    uint32_t id() const;
+
+private:
+    const AST* ast_;
+    uint32_t id_;
+};
+
+// Owns all nodes of a compilation unit. Node values are allocated in an arena
+// and the branches of every node are a contiguous range of node ids.
+class AST
+{
+public:
+    using NodeId = uint32_t;
+    static const NodeId ROOT = 0;
+    static const NodeId NONE = UINT32_MAX;
+
+    AST();
+    AST(const AST&) = delete;
+    AST& operator=(const AST&) = delete;
+
+    template<typename T, typename... Args>
+    NodeId make(Args&&... args);
+    void pushBranch(NodeId node, NodeId branch);
+    void pushFront(NodeId node, NodeId branch);
+    template<typename T, typename... Args>
+    void replaceValue(NodeId node, Args&&... args);
+    void replaceNode(NodeId node, NodeId other);
+    void clearBranches(NodeId node);
+    NodeId copyNode(NodeId node);
+
+    ASTRef root() const;
+    ASTRef operator[](size_t branch_ind) const;
+    size_t branches_num() const;
+    ASNode* value() const;
+    size_t nodes_num() const;
 
     int dot_dump(const char* dump_name) const;
 
 private:
-    void dot_dump(std::ofstream& dump_file) const;
+    friend class ASTRef;
+
+    struct Node
+    {
+        ASNode* value;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    void dot_dump(std::ofstream& dump_file, NodeId id) const;
+
+    Arena arena_;
+    std::vector<Node> nodes_;
+    std::vector<NodeId> branches_;
 };
 
+template<typename T, typename... Args>
+AST::NodeId AST::make(Args&&... args)
+{
+    auto id = static_cast<NodeId>(nodes_.size());
+    nodes_.push_back({arena_.create<T>(std::forward<Args>(args)...), static_cast<uint32_t>(branches_.size()), 0});
+    return id;
+}
+
+template<typename T, typename... Args>
+void AST::replaceValue(NodeId node, Args&&... args)
+{
+    nodes_[node].value = arena_.create<T>(std::forward<Args>(args)...);
+}
+
 #endif // COMPILER_AST_AST_H
\ No newline at end of file
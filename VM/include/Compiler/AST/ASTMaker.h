@@ -9,14 +9,13 @@
 #include "FlexLexer.h"
 #endif
 
-#include <fstream>
 #include <string>
 #include <vector>
 
 class ASTMaker
 {
 public:
-    ASTMaker(std::ifstream* file);
+    ASTMaker(const SourceFile* source);
 
     void make(AST* ast);
     yy::parser::token_type yylex(yy::parser::semantic_type *yylval, yy::parser::location_type* location) const;
@@ -27,12 +26,14 @@ public:
     bool err() const;
     int lineno() const;
     AST* ast();
+    std::vector<AST::NodeId>* pendingBranches();
 
 private:
-    std::vector<std::string> program_;
+    const SourceFile* source_;
     std::unique_ptr<Lexer> lexer_;
     std::vector<std::string> errors_;
     AST* ast_ = nullptr;
+    std::vector<AST::NodeId> pending_branches_;
 };
 
 #endif // COMPILER_AST_ASTMAKER_H
\ No newline at end of file
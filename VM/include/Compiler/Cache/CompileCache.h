@@ -0,0 +1,37 @@
+#ifndef COMPILER_CACHE_COMPILECACHE_H
+#define COMPILER_CACHE_COMPILECACHE_H
+
+#include "Compiler/Source/SourceFile.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// On-disk cache of compiled outputs. An entry is a directory named after the
+// hash of the source text and holds every file emitted for that source.
+class CompileCache
+{
+public:
+    // Bump whenever the emitted bytecode changes for the same source.
+    static constexpr uint32_t FORMAT_VERSION = 8;
+
+    explicit CompileCache(const std::string& dir);
+
+    static uint64_t key(const SourceFile& source, const std::string& code_ext);
+    bool restore(uint64_t key);
+    void store(uint64_t key, const std::vector<std::string>& outputs) const;
+
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    std::filesystem::path entry(uint64_t key) const;
+
+    std::filesystem::path dir_;
+    std::atomic<size_t> hits_ = 0;
+    std::atomic<size_t> misses_ = 0;
+};
+
+#endif // COMPILER_CACHE_COMPILECACHE_H
\ No newline at end of file
@@ -2,7 +2,14 @@
 #define COMPILER_COMPILER_H
 
 #include "Compiler/AST/AST.h"
+#include "Compiler/Cache/CompileCache.h"
+#include "Compiler/Optimizer/Peephole.h"
+#include "Compiler/Report/TimeReport.h"
 
+#include <string>
+#include <vector>
+
+// Holds no per-file state, so one instance may compile many files at once.
 class Compiler
 {
 public:
@@ -13,15 +20,28 @@ public:
         FILE_NOT_FOUND,
     };
 
-    Compiler() = default;
-    int compile(const std::string& input_name, const std::string& code_ext);
-    void printErrors(std::ostream& os) const;
+    struct Unit
+    {
+        std::string input_name;
+        int err = OK;
+        std::vector<std::string> errors;
+        TimeReport report;
+    };
+
+    explicit Compiler(size_t jobs = 1, CompileCache* cache = nullptr, Peephole::Stats* opt_stats = nullptr,
+        bool time_report = false);
+    int compile(const std::string& input_name, const std::string& code_ext,
+        std::vector<std::string>* errors = nullptr, TimeReport* report = nullptr) const;
+    void compile(std::vector<Unit>* units, const std::string& code_ext) const;
 
 private:
-    bool translate(const std::string& code_ext);
+    bool translate(AST* ast, const std::string& code_ext, std::vector<std::string>* outputs,
+        std::vector<std::string>* errors, TimeReport* report) const;
 
-    AST ast_;
-    std::vector<std::string> ast_errors_;
+    size_t jobs_;
+    CompileCache* cache_;
+    Peephole::Stats* opt_stats_;
+    bool time_report_;
 };
 
 #endif // COMPILER_COMPILER_H
\ No newline at end of file
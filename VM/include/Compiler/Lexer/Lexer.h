@@ -5,21 +5,25 @@
 #include "FlexLexer.h"
 #endif
 
+#include "Compiler/Source/SourceFile.h"
 #include "location.hh"
 
-#include <fstream>
-
 class Lexer : public yyFlexLexer
 {
 public:
-    Lexer(std::ifstream* file);
+    Lexer(const SourceFile* source);
 
     void setLocation();
     yy::location getLocation() const;
     int yylex() override;
 
+protected:
+    int LexerInput(char* buf, int max_size) override;
+
 private:
     yy::location location;
+    const SourceFile* source_;
+    size_t pos_ = 0;
 };
 
 #endif // COMPILER_LEXER_LEXER_H
\ No newline at end of file
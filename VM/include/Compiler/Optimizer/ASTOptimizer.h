@@ -0,0 +1,27 @@
+#ifndef COMPILER_OPTIMIZER_ASTOPTIMIZER_H
+#define COMPILER_OPTIMIZER_ASTOPTIMIZER_H
+
+#include "Compiler/AST/AST.h"
+
+// Rewrites arithmetic in place before translation: folds constant
+// subexpressions, drops integer identities and turns multiplications by
+// powers of two into shifts.
+class ASTOptimizer
+{
+public:
+    ASTOptimizer(AST* ast);
+
+    void optimize();
+
+private:
+    void optimize(ASTRef node);
+    void optimizeOperation(ASTRef op_node);
+    bool foldConstants(ASTRef op_node);
+    bool simplifyIdentity(ASTRef op_node, ASTRef value, ASTRef constant, bool constant_lhs);
+    void replaceNumber(ASTRef node, int32_t number);
+    static bool isPure(ASTRef node);
+
+    AST* ast_;
+};
+
+#endif // COMPILER_OPTIMIZER_ASTOPTIMIZER_H
\ No newline at end of file
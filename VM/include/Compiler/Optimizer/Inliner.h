@@ -0,0 +1,40 @@
+#ifndef COMPILER_OPTIMIZER_INLINER_H
+#define COMPILER_OPTIMIZER_INLINER_H
+
+#include "Compiler/AST/AST.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Replaces calls to small static methods of the same class by a copy of the
+// callee's body. Only callees whose body is a single `return expression;`
+// without calls or assignments qualify, so parameters are bound by
+// substituting the arguments and the callee needs no slots of its own.
+class Inliner
+{
+public:
+    Inliner(AST* ast);
+
+    void inlineCalls();
+    size_t inlined() const;
+
+private:
+    void inlineCalls(ASTRef node);
+    bool inlineCall(ASTRef call_node);
+    void substitute(AST::NodeId node, const std::unordered_map<std::string, AST::NodeId>& args);
+
+    AST::NodeId findCallee(const std::string& name, size_t args_num) const;
+    static bool isLeaf(ASTRef node, size_t* size);
+    static void countUses(ASTRef node, std::unordered_map<std::string, size_t>* uses);
+    static void collectNames(ASTRef node, std::unordered_set<std::string>* names);
+
+    AST* ast_;
+    size_t inlined_ = 0;
+
+    const ClassNode* class_ = nullptr;
+    AST::NodeId class_node_ = AST::NONE;
+    std::unordered_set<std::string> caller_names_;
+};
+
+#endif // COMPILER_OPTIMIZER_INLINER_H
\ No newline at end of file
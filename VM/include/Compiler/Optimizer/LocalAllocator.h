@@ -0,0 +1,35 @@
+#ifndef COMPILER_OPTIMIZER_LOCALALLOCATOR_H
+#define COMPILER_OPTIMIZER_LOCALALLOCATOR_H
+
+#include "Compiler/Optimizer/Peephole.h"
+#include "PkmEnums.h"
+
+#include <string>
+#include <vector>
+
+// Renumbers the local slots of one method after a liveness analysis over its
+// bytecode: slots whose values are never live at the same time share a slot
+// of the same type. Parameters keep their slots, they are filled by the caller.
+class LocalAllocator
+{
+public:
+    explicit LocalAllocator(const std::vector<VariableType>& params);
+
+    uint16_t allocate(std::string* bytecode);
+
+private:
+    using Slots = std::vector<bool>;
+
+    void collectSlots(const Peephole::Code& code);
+    void liveness(const Peephole::Code& code, std::vector<Slots>* live_in, std::vector<Slots>* live_out) const;
+    std::vector<Slots> interference(const Peephole::Code& code) const;
+    std::vector<uint16_t> colorSlots(const std::vector<Slots>& interferes) const;
+
+    static VariableType slotType(Opcode op);
+    static bool accessesSlot(Opcode op);
+
+    std::vector<VariableType> params_;
+    std::vector<VariableType> types_;
+};
+
+#endif // COMPILER_OPTIMIZER_LOCALALLOCATOR_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef COMPILER_OPTIMIZER_PEEPHOLE_H
+#define COMPILER_OPTIMIZER_PEEPHOLE_H
+
+#include "Opcodes.h"
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Rewrites short instruction windows of one method according to a pattern
+// table until no pattern matches. Branch targets are tracked as instruction
+// indices, so removing instructions never breaks jumps.
+class Peephole
+{
+public:
+    struct Instruction
+    {
+        Opcode op;
+        uint8_t arg8;
+        uint16_t arg16;
+        int32_t target;
+        // Switch operand words, with offsets replaced by instruction indices.
+        std::vector<int32_t> payload;
+    };
+
+    using Code = std::vector<Instruction>;
+
+    struct Pattern
+    {
+        const char* name;
+        size_t length;
+        bool (*match)(const Code& code, size_t pos);
+        Code (*rewrite)(const Code& code, size_t pos);
+        uint16_t stack_growth;
+    };
+
+    class Stats
+    {
+    public:
+        Stats();
+
+        void add(size_t pattern);
+        size_t hits(size_t pattern) const;
+        void print(std::ostream& os) const;
+
+    private:
+        std::vector<std::atomic<size_t>> hits_;
+    };
+
+    static const std::vector<Pattern>& patterns();
+    static size_t pattern(const std::string& name);
+    static Code decode(const std::string& bytecode);
+    static bool encode(const Code& code, std::string* bytecode);
+    static std::vector<size_t> successors(const Code& code, size_t pos);
+
+    explicit Peephole(Stats* stats = nullptr);
+
+    uint16_t optimize(std::string* bytecode);
+
+private:
+    bool applyPattern(Code* code, size_t pos, const std::vector<bool>& targets);
+
+    Stats* stats_;
+    uint16_t stack_growth_ = 0;
+};
+
+#endif // COMPILER_OPTIMIZER_PEEPHOLE_H
\ No newline at end of file
@@ -10,7 +10,6 @@
 #include "Compiler/AST/AST.h"
 
 #include <algorithm>
-#include <list>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -27,13 +26,12 @@ namespace yy {
 
 parser::token_type yylex(parser::semantic_type* yylval, yy::parser::location_type* location, ASTMaker* maker);
 
-void pushBranch(AST* root, AST* br);
-void pushBranches(AST* root, std::list<AST*>* list);
+size_t beginList(ASTMaker* maker);
+void pushList(ASTMaker* maker, AST::NodeId node);
+void pushBranches(ASTMaker* maker, AST::NodeId root, size_t list);
 
-AST* bindNodes(OperationType op, AST* lhs, AST* rhs = nullptr);
-AST* bindNodes(AST* lhs, AST* rhs);
-
-void deleteList(std::list<AST*>* list);
+AST::NodeId bindNodes(ASTMaker* maker, OperationType op, AST::NodeId lhs, AST::NodeId rhs = AST::NONE);
+AST::NodeId bindNodes(ASTMaker* maker, AST::NodeId lhs, AST::NodeId rhs);
 
 }
 }
@@ -106,57 +104,57 @@ void deleteList(std::list<AST*>* list);
 %left '+' '-' '*' '/'
 
 %nterm
-    <AST*> CLASS_DECLS
-    <AST*> CLASS_DECL
+    <AST::NodeId> CLASS_DECLS
+    <AST::NodeId> CLASS_DECL
 
-    <std::list<AST*>> CLASS_SCOPE
-    <std::list<AST*>> CLASS_FMS
+    <size_t> CLASS_SCOPE
+    <size_t> CLASS_FMS
 
-    <AST*> CLASS_FM
-    <AST*> FIELD
-    <AST*> METHOD
+    <AST::NodeId> CLASS_FM
+    <AST::NodeId> FIELD
+    <AST::NodeId> METHOD
 
     <AccessType>   ACC
     <VariableType> TYPE
     <VariableType> MTYPE
     <MethodType>   MET
 
-    <std::list<AST*>> MPARAMS
-    <std::list<AST*>> FPARAMS
-    <std::list<AST*>> PARAMS
-    <AST*> PARAM
-    <AST*> SCOPE
-
-    <std::list<AST*>> ACTIONS
-    <AST*> ACTION
-
-    <AST*> EXPR
-    <AST*> CONTROL
-    <AST*> ASSIGNMENT
-    <AST*> OP_OR
-    <AST*> OP_AND
-    <AST*> OP_EQ
-    <AST*> OP_COMP
-    <AST*> OP_ADD
-    <AST*> OP_MUL
-    <AST*> CHECK_ASS
-    <AST*> CHECK_OR
-    <AST*> CHECK_AND
-    <AST*> CHECK_EQ
-    <AST*> CHECK_COMP
-    <AST*> CHECK_ADD
-    <AST*> CHECK_MUL
-    <AST*> OBJ
-    <AST*> EXPRINBR
-    <AST*> FUNCTION
-    <AST*> VAR_DECL
-    <AST*> VAR
-    <AST*> NUMBER
-    <AST*> NEW_OBJ
-
-    <AST*> VAR_SQBR
-    <AST*> SQBR
-    <std::list<AST*>> SQBRS
+    <size_t> MPARAMS
+    <size_t> FPARAMS
+    <size_t> PARAMS
+    <AST::NodeId> PARAM
+    <AST::NodeId> SCOPE
+
+    <size_t> ACTIONS
+    <AST::NodeId> ACTION
+
+    <AST::NodeId> EXPR
+    <AST::NodeId> CONTROL
+    <AST::NodeId> ASSIGNMENT
+    <AST::NodeId> OP_OR
+    <AST::NodeId> OP_AND
+    <AST::NodeId> OP_EQ
+    <AST::NodeId> OP_COMP
+    <AST::NodeId> OP_ADD
+    <AST::NodeId> OP_MUL
+    <AST::NodeId> CHECK_ASS
+    <AST::NodeId> CHECK_OR
+    <AST::NodeId> CHECK_AND
+    <AST::NodeId> CHECK_EQ
+    <AST::NodeId> CHECK_COMP
+    <AST::NodeId> CHECK_ADD
+    <AST::NodeId> CHECK_MUL
+    <AST::NodeId> OBJ
+    <AST::NodeId> EXPRINBR
+    <AST::NodeId> FUNCTION
+    <AST::NodeId> VAR_DECL
+    <AST::NodeId> VAR
+    <AST::NodeId> NUMBER
+    <AST::NodeId> NEW_OBJ
+
+    <AST::NodeId> VAR_SQBR
+    <AST::NodeId> SQBR
+    <size_t> SQBRS
 
     <std::string> WORD_DOT_WORD
 ;
@@ -165,37 +163,40 @@ void deleteList(std::list<AST*>* list);
 
 %%
 
-program: CLASS_DECLS                             { maker->ast()->value() = std::make_shared<ASNode>(ASNode()); }
+program: CLASS_DECLS                             { }
 
-CLASS_DECLS: CLASS_DECL CLASS_DECLS              { pushBranch(maker->ast(), $1); }
+CLASS_DECLS: CLASS_DECL CLASS_DECLS              { maker->ast()->pushBranch(AST::ROOT, $1); }
            | %empty                              { }
 ;
 
-CLASS_DECL: CLASS WORD CLASS_SCOPE               { $$ = new AST(std::make_shared<ClassNode>(ClassNode($2))); pushBranches($$, &$3); }
+CLASS_DECL: CLASS WORD CLASS_SCOPE               { $$ = maker->ast()->make<ClassNode>($2); pushBranches(maker, $$, $3); }
           | CLASS WORD error                     { maker->pushTextError("expected ; ", @3); YYABORT; }
           | CLASS error                          { maker->pushTextError("expected class name ", @2); YYABORT; }
 ;
 
-CLASS_SCOPE: OCB CLASS_FMS CCB                   { $$ = std::move($2); }
-           | SCOLON                              { }
-           | OCB CLASS_FMS error                 { deleteList(&$2); maker->pushTextError("expected } ", @3); YYABORT; }
+CLASS_SCOPE: OCB CLASS_FMS CCB                   { $$ = $2; }
+           | SCOLON                              { $$ = beginList(maker); }
+           | OCB CLASS_FMS error                 { maker->pushTextError("expected } ", @3); YYABORT; }
 ;
 
-CLASS_FMS: CLASS_FM CLASS_FMS                    { $2.push_front($1); $$ = std::move($2); }
-         | %empty                                { }
+CLASS_FMS: CLASS_FM CLASS_FMS                    { pushList(maker, $1); $$ = $2; }
+         | %empty                                { $$ = beginList(maker); }
 ;
 
 CLASS_FM: FIELD                                  { $$ = $1; }
         | METHOD                                 { $$ = $1; }
 ;
 
-FIELD: ACC TYPE WORD SCOLON                      { $$ = new AST(std::make_shared<FieldNode>(FieldNode($3, $1, $2))); }
+FIELD: ACC TYPE WORD SCOLON                      { $$ = maker->ast()->make<FieldNode>($3, $1, FieldType::INSTANCE, $2); }
+     | ACC MET MTYPE WORD SCOLON                 { if (($2 == MethodType::NATIVE) || ($3 == VariableType::VOID)) { maker->pushError("invalid field declaration ", @2); YYABORT; }
+                                                   FieldType modifier = ($2 == MethodType::STATIC) ? FieldType::STATIC : FieldType::INSTANCE;
+                                                   $$ = maker->ast()->make<FieldNode>($4, $1, modifier, $3); }
      | ACC TYPE WORD error                       { maker->pushTextError("expected ; ", @4); YYABORT; }
      | ACC TYPE error                            { maker->pushError("expected field name ", @3); YYABORT; }
      | ACC error                                 { maker->pushError("expected field type ", @2); YYABORT; }
 ;
 
-METHOD: ACC MET MTYPE WORD MPARAMS SCOPE         { $$ = new AST(std::make_shared<MethodNode>(MethodNode($4, $1, $2, $3))); pushBranches($$, &$5); pushBranch($$, $6); }
+METHOD: ACC MET MTYPE WORD MPARAMS SCOPE         { $$ = maker->ast()->make<MethodNode>($4, $1, $2, $3); pushBranches(maker, $$, $5); maker->ast()->pushBranch($$, $6); }
       | ACC MET MTYPE WORD MPARAMS error         { maker->pushError("expected { ", @6); YYABORT; }
       | ACC MET MTYPE WORD error                 { maker->pushError("expected ( ", @5); YYABORT; }
       | ACC MET MTYPE error                      { maker->pushError("expected method name ", @4); YYABORT; }
@@ -225,99 +226,99 @@ MET: INSTANCE                                    { $$ = $1; }
    | NATIVE                                      { $$ = $1; }
 ;
 
-MPARAMS: ORB PARAMS CRB                          { $$ = std::move($2); }
+MPARAMS: ORB PARAMS CRB                          { $$ = $2; }
        | ORB error                               { maker->pushTextError("expected ) ", @2); YYABORT; }
 ;
 
-PARAMS: PARAM COMMA PARAMS                       { $3.push_front($1); $$ = std::move($3); }
-      | PARAM                                    { $$ = std::list<AST*>(); $$.push_back($1); }
-      | PARAM error                              { delete $1; maker->pushTextError("expected ) ", @2); YYABORT; }
-      | %empty                                   { }
+PARAMS: PARAM COMMA PARAMS                       { pushList(maker, $1); $$ = $3; }
+      | PARAM                                    { $$ = beginList(maker); pushList(maker, $1); }
+      | PARAM error                              { maker->pushTextError("expected ) ", @2); YYABORT; }
+      | %empty                                   { $$ = beginList(maker); }
 ;
 
-PARAM: TYPE WORD                                 { $$ = new AST(std::make_shared<MethodParameterNode>(MethodParameterNode($2, $1))); }
+PARAM: TYPE WORD                                 { $$ = maker->ast()->make<MethodParameterNode>($2, $1); }
      | TYPE error                                { maker->pushError("expected parameter name ", @2); YYABORT; }
 ;
 
-SCOPE: OCB ACTIONS CCB                           { $$ = new AST(std::make_shared<ScopeNode>(ScopeNode())); pushBranches($$, &$2); }
+SCOPE: OCB ACTIONS CCB                           { $$ = maker->ast()->make<ScopeNode>(); pushBranches(maker, $$, $2); }
      | OCB error                                 { maker->pushTextError("expected } ", @2); YYABORT; }
 ;
 
-ACTIONS: ACTION ACTIONS                          { $2.push_front($1); $$ = std::move($2); }
-       | %empty                                  { }
+ACTIONS: ACTION ACTIONS                          { pushList(maker, $1); $$ = $2; }
+       | %empty                                  { $$ = beginList(maker); }
 ;
 
 ACTION: EXPR SCOLON                              { $$ = $1; }
       | CONTROL                                  { $$ = $1; }
-      | RETURN EXPR SCOLON                       { $$ = new AST(std::make_shared<OperationNode>(OperationNode($1))); pushBranch($$, $2); }
-      | RETURN EXPR error                        { delete $2; maker->pushTextError("expected ; ", @3); YYABORT; }
-      | EXPR error                               { delete $1; maker->pushTextError("expected ; ", @2); YYABORT; }
+      | RETURN EXPR SCOLON                       { $$ = maker->ast()->make<OperationNode>($1); maker->ast()->pushBranch($$, $2); }
+      | RETURN EXPR error                        { maker->pushTextError("expected ; ", @3); YYABORT; }
+      | EXPR error                               { maker->pushTextError("expected ; ", @2); YYABORT; }
 ;
 
-EXPR: CHECK_ASS ASSIGNMENT                       { $$ = bindNodes($1, $2); }
+EXPR: CHECK_ASS ASSIGNMENT                       { $$ = bindNodes(maker, $1, $2); }
 
-ASSIGNMENT: ASSIGN CHECK_ASS ASSIGNMENT          { $$ = bindNodes($1, $2, $3); }
+ASSIGNMENT: ASSIGN CHECK_ASS ASSIGNMENT          { $$ = bindNodes(maker, $1, $2, $3); }
           | ASSIGN error                         { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-          | %empty                               { $$ = nullptr; }
+          | %empty                               { $$ = AST::NONE; }
 ;
 
-CHECK_ASS: CHECK_OR OP_OR                        { $$ = bindNodes($1, $2); }
+CHECK_ASS: CHECK_OR OP_OR                        { $$ = bindNodes(maker, $1, $2); }
 
-OP_OR: OR CHECK_OR OP_OR                         { $$ = bindNodes($1, $2, $3); }
+OP_OR: OR CHECK_OR OP_OR                         { $$ = bindNodes(maker, $1, $2, $3); }
      | OR error                                  { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-     | %empty                                    { $$ = nullptr; }
+     | %empty                                    { $$ = AST::NONE; }
 ;
 
-CHECK_OR: CHECK_AND OP_AND                       { $$ = bindNodes($1, $2); }
+CHECK_OR: CHECK_AND OP_AND                       { $$ = bindNodes(maker, $1, $2); }
 
-OP_AND: AND CHECK_AND OP_AND                     { $$ = bindNodes($1, $2, $3); }
+OP_AND: AND CHECK_AND OP_AND                     { $$ = bindNodes(maker, $1, $2, $3); }
       | AND error                                { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-      | %empty                                   { $$ = nullptr; }
+      | %empty                                   { $$ = AST::NONE; }
 ;
 
-CHECK_AND: CHECK_EQ OP_EQ                        { $$ = bindNodes($1, $2); }
+CHECK_AND: CHECK_EQ OP_EQ                        { $$ = bindNodes(maker, $1, $2); }
 
-OP_EQ: EQ CHECK_EQ OP_EQ                         { $$ = bindNodes($1, $2, $3); }
-     | NEQ CHECK_EQ OP_EQ                        { $$ = bindNodes($1, $2, $3); }
+OP_EQ: EQ CHECK_EQ OP_EQ                         { $$ = bindNodes(maker, $1, $2, $3); }
+     | NEQ CHECK_EQ OP_EQ                        { $$ = bindNodes(maker, $1, $2, $3); }
      | EQ error                                  { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
      | NEQ error                                 { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-     | %empty                                    { $$ = nullptr; }
+     | %empty                                    { $$ = AST::NONE; }
 ;
 
-CHECK_EQ: CHECK_COMP OP_COMP                     { $$ = bindNodes($1, $2); }
+CHECK_EQ: CHECK_COMP OP_COMP                     { $$ = bindNodes(maker, $1, $2); }
 
-OP_COMP: STL CHECK_COMP OP_COMP                  { $$ = bindNodes($1, $2, $3); }
-       | STG CHECK_COMP OP_COMP                  { $$ = bindNodes($1, $2, $3); }
-       | LEQ CHECK_COMP OP_COMP                  { $$ = bindNodes($1, $2, $3); }
-       | GEQ CHECK_COMP OP_COMP                  { $$ = bindNodes($1, $2, $3); }
+OP_COMP: STL CHECK_COMP OP_COMP                  { $$ = bindNodes(maker, $1, $2, $3); }
+       | STG CHECK_COMP OP_COMP                  { $$ = bindNodes(maker, $1, $2, $3); }
+       | LEQ CHECK_COMP OP_COMP                  { $$ = bindNodes(maker, $1, $2, $3); }
+       | GEQ CHECK_COMP OP_COMP                  { $$ = bindNodes(maker, $1, $2, $3); }
        | STL error                               { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
        | STG error                               { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
        | LEQ error                               { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
        | GEQ error                               { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-       | %empty                                  { $$ = nullptr; }
+       | %empty                                  { $$ = AST::NONE; }
 ;
 
-CHECK_COMP: CHECK_ADD OP_ADD                     { $$ = bindNodes($1, $2); }
+CHECK_COMP: CHECK_ADD OP_ADD                     { $$ = bindNodes(maker, $1, $2); }
 
-OP_ADD: ADD CHECK_ADD OP_ADD                     { $$ = bindNodes($1, $2, $3); }
-      | SUB CHECK_ADD OP_ADD                     { $$ = bindNodes($1, $2, $3); }
+OP_ADD: ADD CHECK_ADD OP_ADD                     { $$ = bindNodes(maker, $1, $2, $3); }
+      | SUB CHECK_ADD OP_ADD                     { $$ = bindNodes(maker, $1, $2, $3); }
       | ADD error                                { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
       | SUB error                                { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-      | %empty                                   { $$ = nullptr; }
+      | %empty                                   { $$ = AST::NONE; }
 ;
 
-CHECK_ADD: CHECK_MUL OP_MUL                      { $$ = bindNodes($1, $2); }
+CHECK_ADD: CHECK_MUL OP_MUL                      { $$ = bindNodes(maker, $1, $2); }
 
-OP_MUL: MUL CHECK_MUL OP_MUL                     { $$ = bindNodes($1, $2, $3); }
-      | DIV CHECK_MUL OP_MUL                     { $$ = bindNodes($1, $2, $3); }
+OP_MUL: MUL CHECK_MUL OP_MUL                     { $$ = bindNodes(maker, $1, $2, $3); }
+      | DIV CHECK_MUL OP_MUL                     { $$ = bindNodes(maker, $1, $2, $3); }
       | MUL error                                { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
       | DIV error                                { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
-      | %empty                                   { $$ = nullptr; }
+      | %empty                                   { $$ = AST::NONE; }
 ;
 
 CHECK_MUL: OBJ                                   { $$ = $1; }
-         | ADD OBJ                               { $$ = bindNodes($1, $2, nullptr); }
-         | SUB OBJ                               { $$ = bindNodes($1, $2, nullptr); }
+         | ADD OBJ                               { $$ = bindNodes(maker, $1, $2, AST::NONE); }
+         | SUB OBJ                               { $$ = bindNodes(maker, $1, $2, AST::NONE); }
          | SUB error                             { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
          | ADD error                             { maker->pushTextError("expected primary-expression ", @2); YYABORT; }
          | ASSIGN error                          { maker->pushError("expected primary-expression before token '='" , @2); YYABORT; }
@@ -340,61 +341,61 @@ OBJ: EXPRINBR                                    { $$ = $1; }
    | VAR_SQBR                                    { $$ = $1; }
    | NUMBER                                      { $$ = $1; }
    | NEW_OBJ                                     { $$ = $1; }
-   | STRING                                      { $1.erase($1.begin()); $1.erase(--$1.end()); $$ = new AST(std::make_shared<StringNode>(StringNode($1))); }
-   | SYMBOL                                      { $$ = new AST(std::make_shared<SymbolNode>(SymbolNode($1))); }
+   | STRING                                      { $1.erase($1.begin()); $1.erase(--$1.end()); $$ = maker->ast()->make<StringNode>($1); }
+   | SYMBOL                                      { $$ = maker->ast()->make<SymbolNode>($1); }
 ;
 
 EXPRINBR: ORB EXPR CRB                           { $$ = $2; }
         | ORB error                              { maker->pushTextError("expected ) ", @2); YYABORT; }
 ;
 
-FUNCTION: WORD_DOT_WORD ORB FPARAMS CRB          { $$ = new AST(std::make_shared<FunctionNode>(FunctionNode($1))); pushBranches($$, &$3); }
+FUNCTION: WORD_DOT_WORD ORB FPARAMS CRB          { $$ = maker->ast()->make<FunctionNode>($1); pushBranches(maker, $$, $3); }
         | WORD_DOT_WORD ORB error                { maker->pushTextError("expected ) ", @3); YYABORT; }
 ;
 
-FPARAMS: EXPR COMMA FPARAMS                      { $3.push_front($1); $$ = std::move($3); }
-       | EXPR                                    { $$ = std::list<AST*>(); $$.push_back($1); }
-       | EXPR error                              { delete $1; maker->pushTextError("expected ) ", @2); YYABORT; }
-       | %empty                                  { }
+FPARAMS: EXPR COMMA FPARAMS                      { pushList(maker, $1); $$ = $3; }
+       | EXPR                                    { $$ = beginList(maker); pushList(maker, $1); }
+       | EXPR error                              { maker->pushTextError("expected ) ", @2); YYABORT; }
+       | %empty                                  { $$ = beginList(maker); }
 ;
 
-CONTROL: IF EXPRINBR SCOPE                       { $$ = new AST(std::make_shared<ControlNode>(ControlNode($1))); pushBranch($$, $2); pushBranch($$, $3); }
-       | ELSE SCOPE                              { $$ = new AST(std::make_shared<ControlNode>(ControlNode($1))); pushBranch($$, $2); }
-       | ELIF EXPRINBR SCOPE                     { $$ = new AST(std::make_shared<ControlNode>(ControlNode($1))); pushBranch($$, $2); pushBranch($$, $3); }
-       | WHILE EXPRINBR SCOPE                    { $$ = new AST(std::make_shared<ControlNode>(ControlNode($1))); pushBranch($$, $2); pushBranch($$, $3); }
-       | IF EXPRINBR error                       { delete $2; maker->pushTextError("expected { ", @3); YYABORT; }
+CONTROL: IF EXPRINBR SCOPE                       { $$ = maker->ast()->make<ControlNode>($1); maker->ast()->pushBranch($$, $2); maker->ast()->pushBranch($$, $3); }
+       | ELSE SCOPE                              { $$ = maker->ast()->make<ControlNode>($1); maker->ast()->pushBranch($$, $2); }
+       | ELIF EXPRINBR SCOPE                     { $$ = maker->ast()->make<ControlNode>($1); maker->ast()->pushBranch($$, $2); maker->ast()->pushBranch($$, $3); }
+       | WHILE EXPRINBR SCOPE                    { $$ = maker->ast()->make<ControlNode>($1); maker->ast()->pushBranch($$, $2); maker->ast()->pushBranch($$, $3); }
+       | IF EXPRINBR error                       { maker->pushTextError("expected { ", @3); YYABORT; }
        | IF error                                { maker->pushTextError("expected ( ", @2); YYABORT; }
        | ELSE error                              { maker->pushTextError("expected { ", @2); YYABORT; }
-       | ELIF EXPRINBR error                     { delete $2; maker->pushTextError("expected { ", @3); YYABORT; }
+       | ELIF EXPRINBR error                     { maker->pushTextError("expected { ", @3); YYABORT; }
        | ELIF error                              { maker->pushTextError("expected ( ", @2); YYABORT; }
-       | WHILE EXPRINBR error                    { delete $2; maker->pushTextError("expected { ", @3); YYABORT; }
+       | WHILE EXPRINBR error                    { maker->pushTextError("expected { ", @3); YYABORT; }
        | WHILE error                             { maker->pushTextError("expected ( ", @2); YYABORT; }
 ;
 
-VAR_DECL: TYPE WORD                              { $$ = new AST(std::make_shared<VariableDeclarationNode>(VariableDeclarationNode($2, $1))); }
+VAR_DECL: TYPE WORD                              { $$ = maker->ast()->make<VariableDeclarationNode>($2, $1); }
         | TYPE error                             { maker->pushError("expected variable name ", @2); YYABORT; }
 ;
 
-VAR: WORD_DOT_WORD                               { $$ = new AST(std::make_shared<VariableNode>(VariableNode($1))); }
+VAR: WORD_DOT_WORD                               { $$ = maker->ast()->make<VariableNode>($1); }
 
-VAR_SQBR: VAR SQBRS                              { $$ = new AST(std::make_shared<OperationNode>(OperationNode(OperationType::SQR_BR))); pushBranch($$, $1); pushBranches($$, &$2); }
+VAR_SQBR: VAR SQBRS                              { $$ = maker->ast()->make<OperationNode>(OperationType::SQR_BR); maker->ast()->pushBranch($$, $1); pushBranches(maker, $$, $2); }
 
-SQBRS: SQBR SQBRS                                { $2.push_front($1); $$ = std::move($2); }
-     | SQBR                                      { $$ = std::list<AST*>(); $$.push_back($1); }
+SQBRS: SQBR SQBRS                                { pushList(maker, $1); $$ = $2; }
+     | SQBR                                      { $$ = beginList(maker); pushList(maker, $1); }
 ;
 
 SQBR: OSB EXPR CSB                               { $$ = $2; }
-    | OSB EXPR error                             { delete $2; maker->pushTextError("expected ] ", @3); YYABORT; }
+    | OSB EXPR error                             { maker->pushTextError("expected ] ", @3); YYABORT; }
     | OSB error                                  { maker->pushTextError("expected ] ", @2); YYABORT; }
 ;
 
-NUMBER: INTNUMBER                                { $$ = new AST(std::make_shared<NumberNode>(NumberNode($1))); }
-      | FLOATNUMBER                              { $$ = new AST(std::make_shared<NumberNode>(NumberNode($1))); }
-      | FALSE                                    { $$ = new AST(std::make_shared<NumberNode>(NumberNode(false))); }
-      | TRUE                                     { $$ = new AST(std::make_shared<NumberNode>(NumberNode(true))); }
+NUMBER: INTNUMBER                                { $$ = maker->ast()->make<NumberNode>($1); }
+      | FLOATNUMBER                              { $$ = maker->ast()->make<NumberNode>($1); }
+      | FALSE                                    { $$ = maker->ast()->make<NumberNode>(false); }
+      | TRUE                                     { $$ = maker->ast()->make<NumberNode>(true); }
 ;
 
-NEW_OBJ: NEW WORD                                { $$ = new AST(std::make_shared<OperationNode>(OperationNode($1))); $$->emplace_branch(std::make_shared<TypeNode>(TypeNode($2))); }
+NEW_OBJ: NEW WORD                                { $$ = maker->ast()->make<OperationNode>($1); maker->ast()->pushBranch($$, maker->ast()->make<TypeNode>($2)); }
 
 WORD_DOT_WORD: WORD                              { $$ = std::move($1); }
              | WORD_DOT                          { $$ = std::move($1); }
@@ -409,63 +410,54 @@ parser::token_type yylex(parser::semantic_type* yylval, yy::parser::location_typ
     return maker->yylex(yylval, location);
 }
 
-void pushBranch(AST* root, AST* br)
+size_t beginList(ASTMaker* maker)
 {
-    root->emplace_branch(std::move(*br));
-    delete br;
+    return maker->pendingBranches()->size();
 }
 
-void pushBranches(AST* root, std::list<AST*>* list)
+void pushList(ASTMaker* maker, AST::NodeId node)
 {
-    for (auto& br : *list)
+    maker->pendingBranches()->push_back(node);
+}
+
+// Right-recursive list rules push their elements last to first.
+void pushBranches(ASTMaker* maker, AST::NodeId root, size_t list)
+{
+    std::vector<AST::NodeId>* pending = maker->pendingBranches();
+    for (size_t i = pending->size(); i > list; i--)
     {
-        root->emplace_branch(std::move(*br));
-        delete br;
+        maker->ast()->pushBranch(root, (*pending)[i - 1]);
     }
+    pending->resize(list);
 }
 
-AST* bindNodes(OperationType op, AST* lhs, AST* rhs)
+AST::NodeId bindNodes(ASTMaker* maker, OperationType op, AST::NodeId lhs, AST::NodeId rhs)
 {
-    AST* node = new AST(std::make_shared<OperationNode>(OperationNode(op)));
+    AST::NodeId node = maker->ast()->make<OperationNode>(op);
 
-    if (rhs)
+    if (rhs != AST::NONE)
     {
-        node->emplace_branch(std::move(*rhs));
-        delete rhs;
-
-        (*node)[0].emplace_branch(std::move((*node)[0][0]));
-        (*node)[0][0] = std::move(*lhs);
-        delete lhs;
+        maker->ast()->pushFront(rhs, lhs);
+        maker->ast()->pushBranch(node, rhs);
     }
     else
     {
-        node->emplace_branch(std::move(*lhs));
-        delete lhs;
+        maker->ast()->pushBranch(node, lhs);
     }
 
     return node;
 }
 
-AST* bindNodes(AST* lhs, AST* rhs)
+AST::NodeId bindNodes(ASTMaker* maker, AST::NodeId lhs, AST::NodeId rhs)
 {
-    if (rhs)
+    if (rhs != AST::NONE)
     {
-        rhs->emplace_branch(std::move((*rhs)[0]));
-        (*rhs)[0] = std::move(*lhs);
-        delete lhs;
+        maker->ast()->pushFront(rhs, lhs);
         return rhs;
     }
     return lhs;
 }
 
-void deleteList(std::list<AST*>* list)
-{
-    for (auto& br : *list)
-    {
-        delete br;
-    }
-}
-
 void parser::error(const parser::location_type&, const std::string&) {}
 
 } // namespace yy
\ No newline at end of file
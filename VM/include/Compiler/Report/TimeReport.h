@@ -0,0 +1,63 @@
+#ifndef COMPILER_REPORT_TIMEREPORT_H
+#define COMPILER_REPORT_TIMEREPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Cost of compiling one file, phase by phase. Phases are measured on the
+// compiling thread, so files compiled in parallel do not mix their numbers;
+// peak RSS is the only process-wide value. Allocations are counted by the
+// compiler executable's operator new and stay zero in other programs.
+class TimeReport
+{
+public:
+    struct Phase
+    {
+        const char* name;
+        double ms;
+        uint64_t allocations;
+        uint64_t allocated_bytes;
+        // Peak resident set of the process when the phase ended.
+        long peak_rss_kb;
+    };
+
+    // Adds a phase lasting until end() or destruction; does nothing without a report.
+    class Scope
+    {
+    public:
+        Scope(TimeReport* report, const char* name);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+        void end();
+
+    private:
+        TimeReport* report_;
+        const char* name_;
+        std::chrono::steady_clock::time_point start_;
+        uint64_t allocations_ = 0;
+        uint64_t allocated_bytes_ = 0;
+    };
+
+    static void countAllocation(size_t bytes);
+
+    double totalMs() const;
+    void print(std::ostream& os) const;
+    // Files slowest first, then every phase summed over all files.
+    static void print(std::ostream& os, const std::vector<const TimeReport*>& reports);
+
+    std::string file_name;
+    std::vector<Phase> phases;
+    size_t parsed_nodes = 0;
+    size_t optimized_nodes = 0;
+    // Constant pool entries per emitted class.
+    std::vector<std::pair<std::string, size_t>> constant_pools;
+};
+
+#endif // COMPILER_REPORT_TIMEREPORT_H
\ No newline at end of file
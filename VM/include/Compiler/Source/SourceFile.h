@@ -0,0 +1,31 @@
+#ifndef COMPILER_SOURCE_SOURCEFILE_H
+#define COMPILER_SOURCE_SOURCEFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only memory mapping of a source file. The lexer scans it in place and
+// error messages slice lines out of it, so the text is never copied.
+class SourceFile
+{
+public:
+    explicit SourceFile(const std::string& file_name);
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+    ~SourceFile();
+
+    bool is_open() const;
+    const char* data() const;
+    size_t size() const;
+    std::string_view line(size_t lineno) const;
+
+private:
+    void* region_ = nullptr;
+    size_t size_ = 0;
+    bool opened_ = false;
+    mutable std::vector<size_t> line_starts_;
+};
+
+#endif // COMPILER_SOURCE_SOURCEFILE_H
\ No newline at end of file
@@ -2,7 +2,9 @@
 #define COMPILER_TRANSLATOR_TRANSLATOR_H
 
 #include "Compiler/AST/AST.h"
+#include "Compiler/Optimizer/Peephole.h"
 #include "ConstantPool.h"
+#include "Opcodes.h"
 
 #include <fstream>
 #include <sstream>
@@ -10,29 +12,69 @@
 class Translator
 {
 public:
-    Translator(AST* ast);
+    Translator(AST* ast, size_t class_num = 0, Peephole::Stats* opt_stats = nullptr);
 
     void translate(std::ofstream* file);
+    size_t constants() const;
+    std::vector<std::string>* getErrors();
+    bool err() const;
 
 private:
     void writeConstantPool(std::ofstream* file);
-    void writeFields(AST* class_node, std::stringstream* class_content);
-    void writeMethods(AST* class_node, std::stringstream* class_content, std::stringstream* instructions);
-    void writeMethodParams(AST* method_node, std::stringstream* class_content);
+    void writeFields(ASTRef class_node, std::stringstream* class_content);
+    void writeMethods(ASTRef class_node, std::stringstream* class_content, std::stringstream* instructions);
+    void writeMethodParams(ASTRef method_node, std::stringstream* class_content);
 
     void appendLocal(VariableDeclarationNode* var_decl_node);
-    uint32_t writeInstructions(AST* scope_node, std::stringstream* instructions);
-    VariableType writeObject(AST* obj_node, std::stringstream* instructions);
-    VariableType writeOperation(AST* op_node, std::stringstream* instructions);
-    VariableType writeFunction(AST* func_node, std::stringstream* instructions);
+    uint32_t writeInstructions(ASTRef scope_node, std::stringstream* instructions);
+    void writeIf(ASTRef scope_node, size_t* ind, std::stringstream* instructions);
+    bool writeSwitch(ASTRef scope_node, size_t first, size_t last, std::stringstream* instructions);
+    void writeWhile(ASTRef while_node, std::stringstream* instructions);
+    void writeCondition(ASTRef cond_node, bool jump_if, size_t label, std::stringstream* instructions);
+    VariableType writeComparison(ASTRef op_node, std::stringstream* instructions);
+    VariableType writeObject(ASTRef obj_node, std::stringstream* instructions);
+    VariableType writeOperation(ASTRef op_node, std::stringstream* instructions);
+    VariableType writeFunction(ASTRef func_node, std::stringstream* instructions);
 
     VariableType writeNumber(NumberNode* num_node, std::stringstream* instructions);
     void writeStore(const std::string& name, std::stringstream* instructions);
     VariableType writeLoad(const std::string& name, std::stringstream* instructions);
+    void writeStatic(Opcode op, const std::string& name, std::stringstream* instructions);
+
+    void writeOpcode(Opcode op, std::stringstream* instructions);
+    size_t newLabel();
+    void bindLabel(size_t label, std::stringstream* instructions);
+    void writeBranch(Opcode op, size_t label, std::stringstream* instructions);
+    void writeSwitchTarget(size_t label, uint32_t switch_pos, std::stringstream* instructions);
+    bool resolveLabels(std::string* code) const;
+
+    void pushStack(uint16_t num = 1);
+    void popStack(uint16_t num = 1);
 
     AST* ast_;
+    size_t class_num_;
+    Peephole::Stats* opt_stats_;
     ConstantPool const_pool_;
+    std::string method_name_;
     std::unordered_map<std::string, std::pair<uint16_t, VariableType>> locals_;
+    std::vector<VariableType> params_;
+    uint16_t next_local_ = 0;
+    std::unordered_map<std::string, VariableType> statics_;
+    std::unordered_map<std::string, VariableType> methods_;
+    // Branches are emitted against labels and patched once the method is
+    // complete, so forward jumps need no second pass over the AST.
+    struct Label
+    {
+        int32_t offset;
+        std::vector<uint32_t> branches;
+        // Switch table words with the position of their switch instruction.
+        std::vector<std::pair<uint32_t, uint32_t>> words;
+    };
+
+    std::vector<Label> labels_;
+    uint16_t stack_size_ = 0;
+    uint16_t max_stack_ = 0;
+    std::vector<std::string> errors_;
 };
 
 #endif // COMPILER_TRANSLATOR_TRANSLATOR_H
\ No newline at end of file
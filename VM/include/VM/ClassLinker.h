@@ -4,24 +4,39 @@
 #include "VM/Klass/KlassLoader.h"
 #include "VM/Pkm/PkmClass.h"
 
-using PkmClasses = std::unordered_map<std::string, PkmClass>;
+#include <ostream>
 
 class ClassLinker
 {
 public:
+    enum Errors
+    {
+        OK,
+        KLASS_CORRUPTED,
+        CLASS_NOT_VERIFIED,
+    };
+
     ClassLinker() = default;
-    void link(const Klasses& klasses);
+    int link(const Klasses& klasses);
+    void printErrors(std::ostream& os) const;
 
     PkmClasses classes;
 
 private:
-    void appendClass(const std::string& klass);
-    static std::string getString(const std::string& klass, size_t* pos);
-    void getConstantPool(ConstPool* const_pool, const std::string& klass, size_t* pos);
-    void getFields(PkmFields* fields, const std::string& klass, size_t* pos);
-    void getMethods(PkmMethods* methods, const std::string& klass, size_t* pos);
+    bool appendClass(const std::string& klass);
+    static void allocateStatics(PkmClass* cls);
+    void resolveConstants(const std::string& class_name, PkmClass* cls);
+    void quickenStatics(const std::string& class_name, PkmClass* cls);
+    static bool getString(std::string* str, const std::string& klass, size_t* pos);
+    template<typename T>
+    static bool getValue(T* value, const std::string& klass, size_t* pos);
+    bool getName(std::string* name, uint16_t index) const;
+    bool getConstantPool(ConstPool* const_pool, const std::string& klass, size_t* pos);
+    bool getFields(PkmFields* fields, const std::string& klass, size_t* pos);
+    bool getMethods(PkmMethods* methods, const std::string& klass, size_t* pos);
 
-    ConstPool* const_pool_ptr_;
+    ConstPool* const_pool_ptr_ = nullptr;
+    std::vector<std::string> errors_;
 };
 
 #endif // VM_CLASSLINKER_H
\ No newline at end of file
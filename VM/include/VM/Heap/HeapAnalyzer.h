@@ -0,0 +1,75 @@
+#ifndef VM_HEAP_HEAPANALYZER_H
+#define VM_HEAP_HEAPANALYZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Computes the dominator tree of a heap snapshot and the size each node
+// and each class keeps alive. Records are read one at a time into flat
+// arrays indexed by node number, so memory grows with the graph, not with
+// the file. Nodes unreachable from the roots are counted but not analyzed.
+class HeapAnalyzer
+{
+public:
+    enum Errors
+    {
+        OK,
+        FILE_NOT_OPENED,
+        WRONG_FORMAT,
+    };
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct ClassStats
+    {
+        std::string name;
+        size_t count;
+        uint64_t shallow;
+        // Bytes freed if every object of the class were unreachable.
+        uint64_t retained;
+    };
+
+    int load(const std::string& file_name);
+    void analyze();
+
+    size_t nodes() const;
+    uint32_t index(uint64_t id) const;
+    uint64_t id(uint32_t node) const;
+    // NONE for roots, nodes dominated only by the root set and unreachable nodes.
+    uint32_t dominator(uint32_t node) const;
+    uint64_t retained(uint32_t node) const;
+    // Sorted by retained size.
+    const std::vector<ClassStats>& classes() const;
+
+    void print(std::ostream& os, size_t top = 20) const;
+
+private:
+    void buildPredecessors();
+    void orderNodes();
+    void computeDominators();
+    void computeRetained();
+
+    std::vector<std::string> type_names_;
+    std::unordered_map<uint64_t, uint32_t> index_;
+    std::vector<uint64_t> ids_;
+    std::vector<uint32_t> types_;
+    std::vector<uint64_t> sizes_;
+    std::vector<uint64_t> edge_begin_;
+    std::vector<uint32_t> edges_;
+    std::vector<uint32_t> roots_;
+
+    std::vector<uint64_t> pred_begin_;
+    std::vector<uint32_t> preds_;
+    // Reverse postorder from a virtual root above all roots.
+    std::vector<uint32_t> order_;
+    std::vector<uint32_t> rank_;
+    std::vector<uint32_t> idom_;
+    std::vector<uint64_t> retained_;
+    std::vector<ClassStats> classes_;
+};
+
+#endif // VM_HEAP_HEAPANALYZER_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef VM_HEAP_HEAPDUMPER_H
+#define VM_HEAP_HEAPDUMPER_H
+
+#include "VM/Pkm/PkmClass.h"
+
+#include <string>
+
+// Writes the memory the VM holds for linked classes as a heap snapshot.
+// Every class is a root and owns its constant pool, bytecode, statics and
+// methods; resolved method and static references become edges between
+// classes. Node ids are addresses.
+class HeapDumper
+{
+public:
+    static int dump(const PkmClasses& classes, const std::string& file_name);
+};
+
+#endif // VM_HEAP_HEAPDUMPER_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef VM_HEAP_HEAPSNAPSHOT_H
+#define VM_HEAP_HEAPSNAPSHOT_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary heap snapshot, written and read one record at a time so neither
+// side holds the file in memory:
+//   header  "PKMHEAP\0", uint32 version
+//   TYPE    uint8 tag, uint32 type, uint16 length, name
+//   NODE    uint8 tag, uint64 id, uint32 type, uint64 size, uint32 edges, edges * uint64 id
+//   ROOT    uint8 tag, uint64 id
+//   END     uint8 tag
+// Integers are in host byte order. A type is declared before the first node
+// that uses it; edges may point to nodes that come later.
+struct HeapRecord
+{
+    enum Tag : uint8_t
+    {
+        END,
+        TYPE,
+        NODE,
+        ROOT,
+    };
+
+    Tag tag;
+    uint32_t type;
+    std::string name;
+    uint64_t id;
+    uint64_t size;
+    std::vector<uint64_t> edges;
+};
+
+class HeapSnapshotWriter
+{
+public:
+    enum Errors
+    {
+        OK,
+        FILE_NOT_OPENED,
+        WRITE_FAILED,
+    };
+
+    static const uint32_t VERSION = 1;
+
+    int open(const std::string& file_name);
+    // Ends the snapshot; a file without the END record is incomplete.
+    int close();
+
+    // Declares name on first use.
+    uint32_t type(const std::string& name);
+    void node(uint64_t id, uint32_t type, uint64_t size, const std::vector<uint64_t>& edges);
+    void root(uint64_t id);
+
+private:
+    template<typename T>
+    void put(T value);
+
+    std::ofstream file_;
+    std::unordered_map<std::string, uint32_t> types_;
+};
+
+class HeapSnapshotReader
+{
+public:
+    enum Errors
+    {
+        OK,
+        FILE_NOT_OPENED,
+        WRONG_FORMAT,
+    };
+
+    int open(const std::string& file_name);
+    // Fills only the fields of record its tag uses.
+    int next(HeapRecord* record);
+
+private:
+    template<typename T>
+    bool get(T* value);
+
+    std::ifstream file_;
+};
+
+#endif // VM_HEAP_HEAPSNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef VM_INTERPRETER_ALLOCATIONPROFILER_H
+#define VM_INTERPRETER_ALLOCATIONPROFILER_H
+
+#include "VM/Pkm/PkmMethod.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <tuple>
+
+// Samples allocations made by bytecode about once every interval bytes.
+// Sample points are drawn from an exponential distribution, so every byte
+// has the same chance to be picked and large and small allocations are
+// attributed without bias; each sample is scaled back up to an estimate of
+// the bytes and allocations it stands for. Sites are Class.method:offset of
+// the allocating instruction.
+class AllocationProfiler
+{
+public:
+    enum Errors
+    {
+        OK,
+        ALREADY_RUNNING,
+    };
+
+    static const size_t DEFAULT_INTERVAL = 512 << 10;
+
+    struct Site
+    {
+        const PkmMethod* method;
+        uint32_t offset;
+        // Allocated type, a string that outlives the profiler.
+        const char* type;
+
+        bool operator<(const Site& other) const
+        {
+            return std::tie(method, offset, type) < std::tie(other.method, other.offset, other.type);
+        }
+    };
+
+    struct Stats
+    {
+        size_t samples;
+        double bytes;
+        double count;
+    };
+
+    explicit AllocationProfiler(size_t interval = DEFAULT_INTERVAL);
+    AllocationProfiler(const AllocationProfiler&) = delete;
+    AllocationProfiler& operator=(const AllocationProfiler&) = delete;
+    ~AllocationProfiler();
+
+    int start();
+    void stop();
+
+    static bool active();
+    // pc points to the allocating instruction of method.
+    static void allocate(const PkmMethod* method, const uint8_t* pc, const char* type, size_t bytes);
+
+    std::map<Site, Stats> sites() const;
+    // Estimated totals per site, once ordered by bytes and once by count.
+    void writeSummary(std::ostream& os) const;
+
+private:
+    void sample(const Site& site, size_t bytes);
+
+    size_t interval_;
+    uint32_t generation_ = 0;
+    mutable std::mutex mutex_;
+    std::map<Site, Stats> sites_;
+
+    static std::atomic<AllocationProfiler*> running_;
+    static std::atomic<uint32_t> generation_counter_;
+};
+
+inline bool AllocationProfiler::active()
+{
+    return running_.load(std::memory_order_relaxed) != nullptr;
+}
+
+#endif // VM_INTERPRETER_ALLOCATIONPROFILER_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef VM_INTERPRETER_EXECSTACK_H
+#define VM_INTERPRETER_EXECSTACK_H
+
+#include "VM/Pkm/PkmMethod.h"
+#include "VM/Pkm/PkmValue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Frame layout on the execution stack:
+//   [locals: locals_num slots][Frame][operand stack: max_stack slots]
+// The first met_params.size() locals are the arguments the caller left on
+// top of its own operand stack, so a call copies nothing.
+struct Frame
+{
+    Frame* prev;
+    PkmMethod* method;
+    const uint8_t* pc;
+    PkmValue* locals;
+};
+
+class ExecStack
+{
+public:
+    static const size_t DEFAULT_SIZE = 64 << 20;
+
+    explicit ExecStack(size_t size = DEFAULT_SIZE);
+    ExecStack(const ExecStack&) = delete;
+    ExecStack& operator=(const ExecStack&) = delete;
+    ~ExecStack();
+
+    static ExecStack* current();
+
+    PkmValue* base() const;
+    Frame* pushFrame(Frame* prev, PkmMethod* method, PkmValue* locals) const;
+
+private:
+    void* region_ = nullptr;
+    size_t region_size_ = 0;
+    PkmValue* base_ = nullptr;
+    PkmValue* limit_ = nullptr;
+};
+
+inline Frame* ExecStack::pushFrame(Frame* prev, PkmMethod* method, PkmValue* locals) const
+{
+    auto* frame = reinterpret_cast<Frame*>(locals + method->locals_num);
+    if (reinterpret_cast<PkmValue*>(frame + 1) + method->max_stack > limit_)
+    {
+        return nullptr;
+    }
+
+    size_t params_num = method->met_params.size();
+    std::memset(locals + params_num, 0, (method->locals_num - params_num) * sizeof(PkmValue));
+
+    frame->prev = prev;
+    frame->method = method;
+    frame->locals = locals;
+    return frame;
+}
+
+#endif // VM_INTERPRETER_EXECSTACK_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef VM_INTERPRETER_INTERPRETER_H
+#define VM_INTERPRETER_INTERPRETER_H
+
+#include "VM/Interpreter/ExecStack.h"
+#include "VM/Pkm/PkmClass.h"
+
+#include <vector>
+
+// Runs verified bytecode only: operand types, stack depth and indices are
+// guaranteed by the Verifier, so instructions are executed without checks.
+class Interpreter
+{
+public:
+    enum Errors
+    {
+        OK,
+        STACK_OVERFLOW,
+        ARITHMETIC_ERROR,
+        UNSUPPORTED_OPCODE,
+    };
+
+    static int execute(PkmMethod* method, const std::vector<PkmValue>& args, PkmValue* result);
+
+private:
+    template<bool SAMPLED>
+    static int run(PkmMethod* method, const std::vector<PkmValue>& args, PkmValue* result);
+};
+
+#endif // VM_INTERPRETER_INTERPRETER_H
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef VM_INTERPRETER_OPCODESTATS_H
+#define VM_INTERPRETER_OPCODESTATS_H
+
+#ifdef VM_OPCODE_STATS
+
+#include "Opcodes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Instrumented builds only: every thread counts the opcodes it dispatches,
+// the pairs of adjacent opcodes and the cycles until the next dispatch.
+// Thread counters are merged when the thread exits and the histogram is
+// printed to stderr when the process exits.
+class OpcodeStats
+{
+public:
+    static const size_t OPCODES = 256;
+
+    explicit OpcodeStats(bool merge_on_exit = false);
+    OpcodeStats(const OpcodeStats&) = delete;
+    OpcodeStats& operator=(const OpcodeStats&) = delete;
+    ~OpcodeStats();
+
+    static OpcodeStats* local();
+    static OpcodeStats* total();
+
+    void enter();
+    void leave();
+    void record(uint8_t op);
+
+    uint64_t count(Opcode op) const;
+    uint64_t pairCount(Opcode first, Opcode second) const;
+    void merge(const OpcodeStats& other);
+    void reset();
+    void print(std::ostream& os, size_t top_pairs = 32) const;
+
+    // Keeps the dispatch counters of one Interpreter::execute call.
+    class Scope
+    {
+    public:
+        Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+    };
+
+private:
+    static uint64_t now();
+    void attribute(uint64_t time);
+
+    std::vector<uint64_t> counts_;
+    std::vector<uint64_t> cycles_;
+    std::vector<uint64_t> pairs_;
+    uint16_t prev_ = OPCODES;
+    uint64_t last_ = 0;
+    bool merge_on_exit_ = false;
+};
+
+inline uint64_t OpcodeStats::now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline void OpcodeStats::attribute(uint64_t time)
+{
+    if (prev_ < OPCODES)
+    {
+        cycles_[prev_] += time - last_;
+    }
+    last_ = time;
+}
+
+inline void OpcodeStats::record(uint8_t op)
+{
+    attribute(now());
+    counts_[op]++;
+    if (prev_ < OPCODES)
+    {
+        pairs_[prev_ * OPCODES + op]++;
+    }
+    prev_ = op;
+}
+
+#endif // VM_OPCODE_STATS
+
+#endif // VM_INTERPRETER_OPCODESTATS_H
\ No newline at end of file
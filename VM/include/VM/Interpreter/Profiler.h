@@ -0,0 +1,75 @@
+#ifndef VM_INTERPRETER_PROFILER_H
+#define VM_INTERPRETER_PROFILER_H
+
+#include "VM/Interpreter/ExecStack.h"
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Samples the Pkm frame stack on SIGPROF. While a profiler runs, the
+// interpreter keeps the pc of the top frame up to date and publishes that
+// frame; the handler only copies (method, pc) pairs into storage allocated
+// up front, so it never allocates or locks.
+class Profiler
+{
+public:
+    enum Errors
+    {
+        OK,
+        ALREADY_RUNNING,
+        TIMER_NOT_SET,
+    };
+
+    static const size_t MAX_DEPTH = 128;
+    static const size_t DEFAULT_CAPACITY = 1 << 20;
+
+    explicit Profiler(long interval_us = 1000, size_t capacity = DEFAULT_CAPACITY);
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    ~Profiler();
+
+    int start();
+    void stop();
+
+    static bool active();
+    static void publish(Frame* frame);
+
+    size_t samples() const;
+    size_t dropped() const;
+    // One line per distinct stack, root first: Class.method:offset;... count
+    void writeFolded(std::ostream& os) const;
+
+private:
+    struct Entry
+    {
+        const PkmMethod* method;
+        uint32_t offset;
+    };
+
+    static void onSignal(int signo);
+    void sample();
+
+    long interval_us_;
+    std::vector<Entry> entries_;
+    std::atomic<size_t> used_ = 0;
+    std::atomic<size_t> samples_ = 0;
+    std::atomic<size_t> dropped_ = 0;
+
+    static std::atomic<Profiler*> running_;
+    static thread_local Frame* volatile top_;
+};
+
+inline bool Profiler::active()
+{
+    return running_.load(std::memory_order_relaxed) != nullptr;
+}
+
+inline void Profiler::publish(Frame* frame)
+{
+    std::atomic_signal_fence(std::memory_order_release);
+    top_ = frame;
+}
+
+#endif // VM_INTERPRETER_PROFILER_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef VM_METRICS_METRICS_H
+#define VM_METRICS_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <sys/types.h>
+
+// Runtime counters kept in a POSIX shared-memory segment (/dev/shm/pkm-vm.<pid>
+// by default), so a monitoring process can map and read them at any time
+// without talking to the VM. Fields are only ever appended to Segment; a
+// reader accepts any segment with its magic, its major version and at least
+// the size it knows about.
+class Metrics
+{
+public:
+    enum Errors
+    {
+        OK,
+        ALREADY_OPENED,
+        SEGMENT_NOT_OPENED,
+        WRONG_SEGMENT,
+    };
+
+    static const uint32_t MAGIC = 0x4D4B4D50; // "PMKM"
+    static const uint32_t VERSION = 1;
+    static const size_t GC_PAUSE_BUCKETS = 16;
+
+    using Counter = std::atomic<uint64_t>;
+    static_assert(Counter::is_always_lock_free);
+
+    struct Segment
+    {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t size;
+        uint32_t pid;
+        // Address space reserved for execution stacks, not memory in use.
+        Counter stack_reserved_bytes;
+        // The VM has no collector yet, so these stay zero. Bucket i counts
+        // pauses of at most 2^i microseconds; the last one takes the rest.
+        Counter gc_count;
+        Counter gc_pause_us[GC_PAUSE_BUCKETS];
+        Counter classes_linked;
+        Counter methods_linked;
+        Counter instructions_executed;
+        Counter pni_calls;
+        // Total of the pauses in gc_pause_us, so the histogram has its _sum.
+        Counter gc_pause_us_sum;
+    };
+
+    // Counts in a local variable and publishes every FLUSH_INTERVAL counts
+    // and when destroyed, which keeps shared cache lines out of hot loops.
+    class Tally
+    {
+    public:
+        static const uint64_t FLUSH_INTERVAL = 1 << 20;
+
+        explicit Tally(Counter Segment::*counter) : counter_(counter) {}
+        Tally(const Tally&) = delete;
+        Tally& operator=(const Tally&) = delete;
+        ~Tally() { flush(); }
+
+        void operator++()
+        {
+            if (++count_ == FLUSH_INTERVAL)
+            {
+                flush();
+            }
+        }
+        void flush()
+        {
+            add(counter_, count_);
+            count_ = 0;
+        }
+
+    private:
+        Counter Segment::*counter_;
+        uint64_t count_ = 0;
+    };
+
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    ~Metrics();
+
+    // Creates the segment and makes it the one counters go to.
+    int open(const std::string& name = "");
+    void close();
+
+    static std::string defaultName(pid_t pid);
+    static void add(Counter Segment::*counter, uint64_t value = 1);
+
+private:
+    std::string name_;
+    Segment* segment_ = nullptr;
+
+    static std::atomic<Segment*> current_;
+};
+
+inline void Metrics::add(Counter Segment::*counter, uint64_t value)
+{
+    Segment* segment = current_.load(std::memory_order_relaxed);
+    if (segment && value)
+    {
+        (segment->*counter).fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+// Read-only view of another process's segment.
+class MetricsReader
+{
+public:
+    MetricsReader() = default;
+    MetricsReader(const MetricsReader&) = delete;
+    MetricsReader& operator=(const MetricsReader&) = delete;
+    ~MetricsReader();
+
+    int open(const std::string& name);
+    void close();
+
+    const Metrics::Segment* segment() const;
+    // Prometheus text exposition format.
+    void print(std::ostream& os) const;
+
+private:
+    const Metrics::Segment* segment_ = nullptr;
+    size_t size_ = 0;
+};
+
+#endif // VM_METRICS_METRICS_H
\ No newline at end of file
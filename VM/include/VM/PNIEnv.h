@@ -1,6 +1,7 @@
 #ifndef VM_PNIENV_H
 #define VM_PNIENV_H
 
+#include "VM/Interpreter/Interpreter.h"
 #include "VM/PkmVM.h"
 
 using pclass = PkmClass*;
@@ -15,7 +16,9 @@ public:
 
     pclass findClass(const std::string& class_name);
     static pmethodID getMethodID(pclass cls, const std::string& met_name);
-    static void callMethod(pclass cls, pmethodID mid);
+    static int callMethod(pclass cls, pmethodID mid, const std::vector<PkmValue>& args = {}, PkmValue* result = nullptr);
+    // Returns a HeapSnapshotWriter error.
+    int dumpHeap(const std::string& file_name) const;
 
     PkmVM* pvm_;
 private:
@@ -0,0 +1,45 @@
+#ifndef VM_PERF_PERFMAP_H
+#define VM_PERF_PERFMAP_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+// Names code ranges for Linux perf. The perf map (<dir>/perf-<pid>.map) is
+// read by perf report as is; the jitdump (<dir>/jit-<pid>.dump) also keeps
+// the code bytes and load times for `perf inject --jit` and needs
+// `perf record -k mono`. Only ranges the CPU executes belong here, so the
+// interpreter registers nothing until compiled code exists.
+class PerfMap
+{
+public:
+    enum Errors
+    {
+        OK,
+        FILE_NOT_OPENED,
+    };
+
+    PerfMap() = default;
+    PerfMap(const PerfMap&) = delete;
+    PerfMap& operator=(const PerfMap&) = delete;
+    ~PerfMap();
+
+    int open(bool jitdump, const std::string& dir = "/tmp");
+    void close();
+    bool is_open() const;
+
+    void addCode(const void* start, size_t size, const std::string& name);
+
+private:
+    void writeRecord(uint32_t id, const void* body, size_t body_size, const void* tail, size_t tail_size);
+
+    std::mutex mutex_;
+    FILE* map_ = nullptr;
+    FILE* dump_ = nullptr;
+    void* marker_ = nullptr;
+    size_t marker_size_ = 0;
+    uint64_t code_index_ = 0;
+};
+
+#endif // VM_PERF_PERFMAP_H
\ No newline at end of file
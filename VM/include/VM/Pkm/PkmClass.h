@@ -4,6 +4,7 @@
 #include "ConstantPool.h"
 #include "VM/Pkm/PkmField.h"
 #include "VM/Pkm/PkmMethod.h"
+#include "VM/Pkm/PkmValue.h"
 
 #include <unordered_map>
 
@@ -13,10 +14,17 @@ using PkmMethods = std::unordered_map<std::string, PkmMethod>;
 
 struct PkmClass
 {
+    std::string name;
     ConstPool const_pool;
     PkmFields fields;
     PkmMethods methods;
     std::string bytecode;
+    std::vector<PkmValue> constants;
+    std::vector<PkmMethod*> method_refs;
+    std::vector<PkmValue> statics;
+    std::vector<PkmValue*> static_refs;
 };
 
+using PkmClasses = std::unordered_map<std::string, PkmClass>;
+
 #endif // VM_PKM_PKMCLASS_H
\ No newline at end of file
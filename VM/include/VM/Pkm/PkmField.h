@@ -8,8 +8,10 @@
 struct PkmField
 {
     AccessType access_type;
+    FieldType modifier;
     VariableType var_type;
     uint16_t name;
+    uint16_t index = 0;
 };
 
 #endif // VM_PKM_PKMFIELD_H
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 
+struct PkmClass;
+
 struct PkmMethod
 {
     AccessType access_type;
@@ -13,8 +15,10 @@ struct PkmMethod
     VariableType ret_type;
     uint16_t name;
     uint16_t locals_num;
+    uint16_t max_stack;
     uint32_t offset;
     std::vector<VariableType> met_params;
+    PkmClass* cls = nullptr;
 };
 
 #endif // VM_PKM_PKMMETHOD_H
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef VM_PKM_PKMVALUE_H
+#define VM_PKM_PKMVALUE_H
+
+#include <cstdint>
+
+// Every local and operand stack slot is one untagged 8-byte value. The Verifier
+// proves the type held by each slot at each instruction, so the interpreter
+// reads the matching member without tags or two-slot longs and doubles.
+union PkmValue
+{
+    int32_t i;
+    int64_t l;
+    float f;
+    double d;
+    void* ref;
+};
+
+static_assert(sizeof(PkmValue) == sizeof(uint64_t));
+
+#endif // VM_PKM_PKMVALUE_H
@@ -0,0 +1,131 @@
+#ifndef VM_TRACE_TRACER_H
+#define VM_TRACE_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Timeline of VM activity. Every thread appends fixed-size binary events to
+// its own single-producer ring without locks; a background thread drains
+// the rings into a Chrome Trace Event JSON file that chrome://tracing and
+// Perfetto open. While no tracer runs, an event costs one load and branch.
+class Tracer
+{
+public:
+    enum Errors
+    {
+        OK,
+        ALREADY_RUNNING,
+        FILE_NOT_OPENED,
+    };
+
+    static const size_t RING_SIZE = 1 << 12;
+    static const size_t DETAIL_SIZE = 32;
+
+    struct Event
+    {
+        uint64_t start;
+        uint64_t duration;
+        const char* category;
+        const char* name;
+        char detail[DETAIL_SIZE];
+    };
+
+    // Records a complete event spanning the lifetime of the scope.
+    class Scope
+    {
+    public:
+        Scope(const char* category, const char* name);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+        void detail(const std::string& text);
+
+    private:
+        Event event_;
+        bool active_;
+    };
+
+    explicit Tracer(std::chrono::milliseconds flush_interval = std::chrono::milliseconds(10));
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    ~Tracer();
+
+    int start(const std::string& file_name);
+    void stop();
+
+    static bool enabled();
+    static void instant(const char* category, const char* name, const std::string& detail = {});
+
+    size_t written() const;
+    size_t dropped() const;
+
+private:
+    struct Ring;
+
+    static std::vector<std::unique_ptr<Ring>>& rings();
+    static Ring* localRing();
+    static uint64_t now();
+    static void setDetail(Event* event, const std::string& text);
+    static void push(const Event& event);
+
+    void flushLoop();
+    void flush();
+
+    std::chrono::milliseconds flush_interval_;
+    std::ofstream file_;
+    std::thread flusher_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    size_t written_ = 0;
+
+    static std::atomic<bool> enabled_;
+    static std::atomic<Tracer*> running_;
+    static std::atomic<size_t> dropped_;
+    static std::mutex rings_mutex_;
+};
+
+inline bool Tracer::enabled()
+{
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+inline Tracer::Scope::Scope(const char* category, const char* name) : active_(enabled())
+{
+    if (active_)
+    {
+        event_.start = now();
+        event_.category = category;
+        event_.name = name;
+        event_.detail[0] = '\0';
+    }
+}
+
+inline Tracer::Scope::~Scope()
+{
+    if (active_)
+    {
+        event_.duration = now() - event_.start;
+        push(event_);
+    }
+}
+
+inline void Tracer::Scope::detail(const std::string& text)
+{
+    if (active_)
+    {
+        setDetail(&event_, text);
+    }
+}
+
+#endif // VM_TRACE_TRACER_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef VM_VERIFIER_H
+#define VM_VERIFIER_H
+
+#include "VM/Pkm/PkmClass.h"
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One pass over every method proves that the interpreter may run it without
+// per-instruction checks: operand stack never underflows and has the same
+// shape on every path into an instruction, each local slot keeps one type,
+// constant pool and local indices are in range, branches land on instructions
+// of the same method and never inside a switch table, calls match the callee
+// signature and static field accesses match the field type.
+class Verifier
+{
+public:
+    explicit Verifier(PkmClasses* classes);
+
+    bool verify();
+    std::vector<std::string>* getErrors();
+    void printErrors(std::ostream& os) const;
+    bool err() const;
+
+    static PkmMethod* resolveMethod(PkmClasses* classes, const std::string& class_name, const std::string& method_ref);
+    static PkmField* resolveField(PkmClasses* classes, const std::string& class_name, const std::string& field_ref,
+        PkmClass** owner = nullptr);
+
+private:
+    static PkmClass* resolveOwner(PkmClasses* classes, const std::string& class_name, const std::string& ref,
+        std::string* member_name);
+
+    bool verifyClass(const std::string& class_name, PkmClass* cls);
+    bool verifyMethod(const std::string& method_name, PkmMethod* method, uint32_t end);
+    bool verifyInstruction(uint32_t pos, uint8_t op, uint16_t arg);
+    bool verifyInvoke(uint16_t index, MethodType modifier);
+    bool verifyStatic(uint16_t index, bool put);
+    std::vector<int32_t> branchOffsets(uint32_t pos) const;
+    bool checkLookupKeys(uint32_t pos, uint16_t num);
+    bool checkBranch(uint32_t pos, int32_t offset);
+    bool mergeBranch(uint32_t pos, int32_t offset);
+
+    bool pop(VariableType var_type);
+    bool popAny(VariableType* var_type = nullptr);
+    bool push(VariableType var_type);
+    bool load(uint16_t index, VariableType var_type);
+    bool store(uint16_t index, VariableType var_type);
+    bool local(uint16_t index, VariableType var_type);
+    const AbstractType* constant(uint16_t index);
+
+    void pushError(const std::string& error, uint32_t pos);
+
+    PkmClasses* classes_;
+    std::vector<std::string> errors_;
+
+    const std::string* class_name_ = nullptr;
+    PkmClass* cls_ = nullptr;
+    const std::string* method_name_ = nullptr;
+    PkmMethod* method_ = nullptr;
+    uint32_t begin_ = 0;
+    uint32_t end_ = 0;
+
+    std::vector<VariableType> stack_;
+    std::vector<VariableType> locals_;
+    std::vector<bool> starts_;
+    std::vector<std::optional<std::vector<VariableType>>> states_;
+    uint32_t pos_ = 0;
+};
+
+#endif // VM_VERIFIER_H
\ No newline at end of file
@@ -42,6 +42,7 @@ static const std::string OPERATION[] = {
     "[]",
     "new",
     "return",
+    "<<",
 };
 
 static const std::string CONTROL[] = {
@@ -74,8 +75,8 @@ std::string ClassNode::print() const
     return "class " + name;
 }
 
-FieldNode::FieldNode(std::string name_, AccessType access_type_, VariableType var_type_) :
-    name(std::move(name_)), access_type(access_type_), var_type(var_type_)
+FieldNode::FieldNode(std::string name_, AccessType access_type_, FieldType modifier_, VariableType var_type_) :
+    name(std::move(name_)), access_type(access_type_), modifier(modifier_), var_type(var_type_)
 {}
 
 NodeType FieldNode::type() const
@@ -85,7 +86,8 @@ NodeType FieldNode::type() const
 
 std::string FieldNode::print() const
 {
-    return ACCESS[static_cast<int>(access_type)] + " " + TYPES[static_cast<int>(var_type)] + " " + name;
+    std::string modifier_str = (modifier == FieldType::STATIC) ? "static " : "";
+    return ACCESS[static_cast<int>(access_type)] + " " + modifier_str + TYPES[static_cast<int>(var_type)] + " " + name;
 }
 
 MethodNode::MethodNode(std::string name_, AccessType access_type_, MethodType modifier_, VariableType ret_type_) :
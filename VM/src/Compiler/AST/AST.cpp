@@ -1,6 +1,114 @@
 #include "Compiler/AST/AST.h"
 
-AST::AST(std::shared_ptr<ASNode> value) : Tree(std::move(value)) {}
+ASTRef::ASTRef(const AST* ast, uint32_t id) : ast_(ast), id_(id) {}
+
+ASTRef ASTRef::operator[](size_t branch_ind) const
+{
+    return ASTRef(ast_, ast_->branches_[ast_->nodes_[id_].first + branch_ind]);
+}
+
+size_t ASTRef::branches_num() const
+{
+    return ast_->nodes_[id_].count;
+}
+
+ASNode* ASTRef::value() const
+{
+    return ast_->nodes_[id_].value;
+}
+
+uint32_t ASTRef::id() const
+{
+    return id_;
+}
+
+AST::AST()
+{
+    make<ASNode>();
+}
+
+void AST::pushBranch(NodeId node, NodeId branch)
+{
+    Node& parent = nodes_[node];
+    if (parent.first + parent.count != branches_.size())
+    {
+        auto first = static_cast<uint32_t>(branches_.size());
+        for (uint32_t i = 0; i < parent.count; i++)
+        {
+            branches_.push_back(branches_[parent.first + i]);
+        }
+        parent.first = first;
+    }
+
+    branches_.push_back(branch);
+    parent.count++;
+}
+
+void AST::pushFront(NodeId node, NodeId branch)
+{
+    Node& parent = nodes_[node];
+    auto first = static_cast<uint32_t>(branches_.size());
+    branches_.push_back(branch);
+    for (uint32_t i = 0; i < parent.count; i++)
+    {
+        branches_.push_back(branches_[parent.first + i]);
+    }
+    parent.first = first;
+    parent.count++;
+}
+
+void AST::replaceNode(NodeId node, NodeId other)
+{
+    nodes_[node] = nodes_[other];
+}
+
+void AST::clearBranches(NodeId node)
+{
+    nodes_[node].count = 0;
+}
+
+// Values are shared with the original subtree, they are only ever replaced.
+AST::NodeId AST::copyNode(NodeId node)
+{
+    std::vector<NodeId> branches;
+    for (uint32_t i = 0; i < nodes_[node].count; i++)
+    {
+        branches.push_back(copyNode(branches_[nodes_[node].first + i]));
+    }
+
+    auto id = static_cast<NodeId>(nodes_.size());
+    nodes_.push_back({nodes_[node].value, static_cast<uint32_t>(branches_.size()), 0});
+    for (NodeId branch : branches)
+    {
+        pushBranch(id, branch);
+    }
+    return id;
+}
+
+ASTRef AST::root() const
+{
+    return ASTRef(this, ROOT);
+}
+
+ASTRef AST::operator[](size_t branch_ind) const
+{
+    return root()[branch_ind];
+}
+
+size_t AST::branches_num() const
+{
+    return root().branches_num();
+}
+
+ASNode* AST::value() const
+{
+    return root().value();
+}
+
+size_t AST::nodes_num() const
+{
+    return nodes_.size();
+}
 
 int AST::dot_dump(const char* dump_name) const
 {
@@ -16,7 +124,7 @@ int AST::dot_dump(const char* dump_name) const
                  " rankdir = HR;\n"
                  " node[shape=box];\n";
 
-    dot_dump(dump_file);
+    dot_dump(dump_file, ROOT);
 
     dump_file << "\tlabelloc=\"t\";"
                  "\tlabel=\""
@@ -31,18 +139,19 @@ int AST::dot_dump(const char* dump_name) const
     return system(command);
 }
 
-void AST::dot_dump(std::ofstream& dump_file) const
+void AST::dot_dump(std::ofstream& dump_file, NodeId id) const
 {
-    dump_file << "\t\"" << this << "\"[shape = box, style = filled, color = black, fillcolor = lightskyblue, label = \""
-              << value_->print() << "\"]\n";
+    ASTRef node(this, id);
+    dump_file << "\t\"" << id << "\"[shape = box, style = filled, color = black, fillcolor = lightskyblue, label = \""
+              << node.value()->print() << "\"]\n";
 
-    for (const auto& node : branches_)
+    for (size_t i = 0; i < node.branches_num(); i++)
     {
-        dump_file << "\t\"" << this << "\" -> \"" << &node << "\"\n";
+        dump_file << "\t\"" << id << "\" -> \"" << node[i].id() << "\"\n";
     }
 
-    for (const auto& node : branches_)
+    for (size_t i = 0; i < node.branches_num(); i++)
     {
-        static_cast<const AST*>(&node)->dot_dump(dump_file);
+        dot_dump(dump_file, node[i].id());
     }
 }
\ No newline at end of file
@@ -2,17 +2,7 @@
 
 #include <cstring>
 
-ASTMaker::ASTMaker(std::ifstream* file) : lexer_(new Lexer(file))
-{
-    while (*file)
-    {
-        std::string line;
-        std::getline(*file, line);
-        program_.push_back(line);
-    }
-    file->clear();
-    file->seekg(0);
-}
+ASTMaker::ASTMaker(const SourceFile* source) : source_(source), lexer_(new Lexer(source)) {}
 
 void ASTMaker::make(AST* ast)
 {
@@ -188,7 +178,7 @@ void ASTMaker::pushError(const std::string& error, const yy::location& location)
     column.push_back('^');
 
     errors_.push_back("line: " + std::to_string(lexer_->lineno() - 1) + " | error: " + error + "\n\t| " + \
-        program_[lexer_->lineno() - 2] + column
+        std::string(source_->line(lexer_->lineno() - 1)) + column
     );
 }
 
@@ -230,4 +220,9 @@ int ASTMaker::lineno() const
 AST* ASTMaker::ast()
 {
     return ast_;
+}
+
+std::vector<AST::NodeId>* ASTMaker::pendingBranches()
+{
+    return &pending_branches_;
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "Compiler/Cache/CompileCache.h"
+
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+static const uint64_t FNV_OFFSET = 0xCBF29CE484222325ULL;
+static const uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+CompileCache::CompileCache(const std::string& dir) : dir_(dir)
+{
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+}
+
+uint64_t CompileCache::key(const SourceFile& source, const std::string& code_ext)
+{
+    uint32_t version = FORMAT_VERSION;
+    uint64_t hash = fnv1a(FNV_OFFSET, reinterpret_cast<const char*>(&version), sizeof(version));
+    hash = fnv1a(hash, code_ext.data(), code_ext.size() + 1);
+    return fnv1a(hash, source.data(), source.size());
+}
+
+bool CompileCache::restore(uint64_t key)
+{
+    std::error_code ec;
+    fs::directory_iterator it(entry(key), ec);
+    bool hit = !ec;
+    for (; hit && (it != fs::directory_iterator()); it.increment(ec))
+    {
+        hit = fs::copy_file(it->path(), it->path().filename(), fs::copy_options::overwrite_existing, ec) && !ec;
+    }
+
+    (hit ? hits_ : misses_)++;
+    return hit;
+}
+
+// Outputs are gathered in a private directory first and then renamed into
+// place, so concurrent compilers never observe a partially written entry.
+void CompileCache::store(uint64_t key, const std::vector<std::string>& outputs) const
+{
+    fs::path target = entry(key);
+    fs::path tmp = target;
+    tmp += "." + std::to_string(getpid()) + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    std::error_code ec;
+    fs::create_directories(tmp, ec);
+    for (const auto& output : outputs)
+    {
+        if (!ec)
+        {
+            fs::copy_file(output, tmp / fs::path(output).filename(), fs::copy_options::overwrite_existing, ec);
+        }
+    }
+
+    if (!ec)
+    {
+        fs::rename(tmp, target, ec);
+    }
+    if (ec)
+    {
+        fs::remove_all(tmp, ec);
+    }
+}
+
+size_t CompileCache::hits() const
+{
+    return hits_;
+}
+
+size_t CompileCache::misses() const
+{
+    return misses_;
+}
+
+fs::path CompileCache::entry(uint64_t key) const
+{
+    char name[17] = {};
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return dir_ / name;
+}
\ No newline at end of file
@@ -1,22 +1,81 @@
 #include "Compiler/AST/ASTMaker.h"
 #include "Compiler/Compiler.h"
+#include "Compiler/Optimizer/ASTOptimizer.h"
+#include "Compiler/Optimizer/Inliner.h"
+#include "Compiler/Source/SourceFile.h"
 #include "Compiler/Translator/Translator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <thread>
 
-int Compiler::compile(const std::string& input_name, const std::string& code_ext)
+Compiler::Compiler(size_t jobs, CompileCache* cache, Peephole::Stats* opt_stats, bool time_report) :
+    jobs_(std::max<size_t>(jobs, 1)), cache_(cache), opt_stats_(opt_stats), time_report_(time_report)
+{}
+
+int Compiler::compile(const std::string& input_name, const std::string& code_ext,
+    std::vector<std::string>* errors, TimeReport* report) const
 {
-    std::ifstream file(input_name);
-    if (file.is_open())
+    if (report)
     {
-        ASTMaker ast_maker(&file);
-        ast_maker.make(&ast_);
+        report->file_name = input_name;
+    }
 
-        if (ast_maker.err() || (ast_.branches_num() == 0) || !translate(code_ext))
+    TimeReport::Scope read_phase(report, "read");
+    SourceFile source(input_name);
+    read_phase.end();
+    if (source.is_open())
+    {
+        TimeReport::Scope cache_phase(cache_ ? report : nullptr, "cache");
+        uint64_t key = cache_ ? CompileCache::key(source, code_ext) : 0;
+        if (cache_ && cache_->restore(key))
         {
-            ast_errors_ = std::move(*ast_maker.getErrors());
+            return OK;
+        }
+        cache_phase.end();
+
+        AST ast;
+        ASTMaker ast_maker(&source);
+        {
+            TimeReport::Scope parse_phase(report, "parse");
+            ast_maker.make(&ast);
+        }
+        size_t parsed_nodes = ast.nodes_num();
+        if (!ast_maker.err())
+        {
+            TimeReport::Scope inline_phase(report, "inline");
+            Inliner inliner(&ast);
+            inliner.inlineCalls();
+            inline_phase.end();
+
+            TimeReport::Scope optimize_phase(report, "optimize");
+            ASTOptimizer optimizer(&ast);
+            optimizer.optimize();
+        }
+        if (report)
+        {
+            report->parsed_nodes = parsed_nodes;
+            report->optimized_nodes = ast.nodes_num();
+        }
+
+        std::vector<std::string> outputs;
+        std::vector<std::string> trans_errors;
+        if (ast_maker.err() || (ast.branches_num() == 0) ||
+            !translate(&ast, code_ext, &outputs, &trans_errors, report))
+        {
+            if (errors)
+            {
+                *errors = ast_maker.err() ? std::move(*ast_maker.getErrors()) : std::move(trans_errors);
+            }
             return FILE_NOT_COMPILED;
         }
+
+        if (cache_)
+        {
+            TimeReport::Scope store_phase(report, "cache store");
+            cache_->store(key, outputs);
+        }
     }
     else
     {
@@ -26,15 +85,55 @@ int Compiler::compile(const std::string& input_name, const std::string& code_ext
     return OK;
 }
 
-bool Compiler::translate(const std::string& code_ext)
+// Workers claim units through a shared counter and write results only into
+// their own unit, so the output order does not depend on scheduling.
+void Compiler::compile(std::vector<Unit>* units, const std::string& code_ext) const
 {
-    for (size_t i = 0; i < ast_.branches_num(); i++)
+    std::atomic<size_t> next = 0;
+    auto worker = [&]()
     {
-        std::ofstream file(static_cast<ClassNode*>(ast_[i].value().get())->name + code_ext);
+        for (size_t i = next++; i < units->size(); i = next++)
+        {
+            Unit& unit = (*units)[i];
+            unit.err = compile(unit.input_name, code_ext, &unit.errors, time_report_ ? &unit.report : nullptr);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(jobs_, units->size()); i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+bool Compiler::translate(AST* ast, const std::string& code_ext, std::vector<std::string>* outputs,
+    std::vector<std::string>* errors, TimeReport* report) const
+{
+    TimeReport::Scope translate_phase(report, "translate");
+    for (size_t i = 0; i < ast->branches_num(); i++)
+    {
+        const std::string& class_name = static_cast<ClassNode*>((*ast)[i].value())->name;
+        outputs->push_back(class_name + code_ext);
+        std::ofstream file(outputs->back());
         if (file.is_open())
         {
-            Translator trans(&ast_);
+            Translator trans(ast, i, opt_stats_);
             trans.translate(&file);
+            if (report)
+            {
+                report->constant_pools.emplace_back(class_name, trans.constants());
+            }
+            if (trans.err())
+            {
+                *errors = std::move(*trans.getErrors());
+                return false;
+            }
         }
         else
         {
@@ -44,12 +143,4 @@ bool Compiler::translate(const std::string& code_ext)
     }
 
     return true;
-}
-
-void Compiler::printErrors(std::ostream& os) const
-{
-    for (const auto& err: ast_errors_)
-    {
-        os << err << "\n";
-    }
 }
\ No newline at end of file
@@ -1,6 +1,23 @@
 #include "Compiler/Lexer/Lexer.h"
 
-Lexer::Lexer(std::ifstream* file) : yyFlexLexer(file) {}
+#include <algorithm>
+#include <cstring>
+
+Lexer::Lexer(const SourceFile* source) : source_(source) {}
+
+// The C++ scanner has no yy_scan_buffer, so the mapped text is fed through
+// LexerInput instead of an istream.
+int Lexer::LexerInput(char* buf, int max_size)
+{
+    size_t len = std::min(source_->size() - pos_, static_cast<size_t>(max_size));
+    if (len == 0)
+    {
+        return 0;
+    }
+    std::memcpy(buf, source_->data() + pos_, len);
+    pos_ += len;
+    return static_cast<int>(len);
+}
 
 void Lexer::setLocation()
 {
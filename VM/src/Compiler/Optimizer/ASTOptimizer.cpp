@@ -0,0 +1,214 @@
+#include "Compiler/Optimizer/ASTOptimizer.h"
+
+#include <bit>
+
+static bool isInt(const ASNode* node)
+{
+    if (node->type() != NodeType::NUMBER)
+    {
+        return false;
+    }
+    VariableType num_type = static_cast<const NumberNode*>(node)->num_type;
+    return (num_type == VariableType::INT) || (num_type == VariableType::BOOLEAN);
+}
+
+static bool isFloat(const ASNode* node)
+{
+    return (node->type() == NodeType::NUMBER) &&
+           (static_cast<const NumberNode*>(node)->num_type == VariableType::FLOAT);
+}
+
+// Integer arithmetic wraps around exactly like the interpreter's.
+static bool foldInt(OperationType op_type, int32_t lhs, int32_t rhs, int32_t* result)
+{
+    auto ulhs = static_cast<uint32_t>(lhs);
+    auto urhs = static_cast<uint32_t>(rhs);
+    switch (op_type)
+    {
+    case OperationType::ADD:
+        *result = static_cast<int32_t>(ulhs + urhs);
+        return true;
+    case OperationType::SUB:
+        *result = static_cast<int32_t>(ulhs - urhs);
+        return true;
+    case OperationType::MUL:
+        *result = static_cast<int32_t>(ulhs * urhs);
+        return true;
+    case OperationType::DIV:
+        if (rhs == 0)
+        {
+            return false;
+        }
+        *result = (rhs == -1) ? static_cast<int32_t>(0U - ulhs) : lhs / rhs;
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+static float foldFloat(OperationType op_type, float lhs, float rhs)
+{
+    switch (op_type)
+    {
+    case OperationType::ADD:
+        return lhs + rhs;
+    case OperationType::SUB:
+        return lhs - rhs;
+    case OperationType::MUL:
+        return lhs * rhs;
+    default:
+        return lhs / rhs;
+    }
+}
+
+ASTOptimizer::ASTOptimizer(AST* ast) : ast_(ast) {}
+
+void ASTOptimizer::optimize()
+{
+    optimize(ast_->root());
+}
+
+void ASTOptimizer::optimize(ASTRef node)
+{
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        optimize(node[i]);
+    }
+
+    if (node.value()->type() == NodeType::OPERATION)
+    {
+        optimizeOperation(node);
+    }
+}
+
+void ASTOptimizer::optimizeOperation(ASTRef op_node)
+{
+    OperationType op_type = static_cast<OperationNode*>(op_node.value())->op_type;
+    if ((op_type != OperationType::ADD) && (op_type != OperationType::SUB) &&
+        (op_type != OperationType::MUL) && (op_type != OperationType::DIV))
+    {
+        return;
+    }
+
+    if (op_node.branches_num() == 1)
+    {
+        ASTRef operand = op_node[0];
+        if (op_type == OperationType::ADD)
+        {
+            ast_->replaceNode(op_node.id(), operand.id());
+        }
+        else if ((op_type == OperationType::SUB) && isInt(operand.value()))
+        {
+            replaceNumber(op_node, static_cast<int32_t>(0U - static_cast<uint32_t>(
+                static_cast<NumberNode*>(operand.value())->number.i)));
+        }
+        else if ((op_type == OperationType::SUB) && isFloat(operand.value()))
+        {
+            ast_->replaceValue<NumberNode>(op_node.id(), -static_cast<NumberNode*>(operand.value())->number.f);
+            ast_->clearBranches(op_node.id());
+        }
+        return;
+    }
+
+    if (!foldConstants(op_node) && !simplifyIdentity(op_node, op_node[0], op_node[1], false))
+    {
+        simplifyIdentity(op_node, op_node[1], op_node[0], true);
+    }
+}
+
+bool ASTOptimizer::foldConstants(ASTRef op_node)
+{
+    OperationType op_type = static_cast<OperationNode*>(op_node.value())->op_type;
+    ASNode* lhs = op_node[0].value();
+    ASNode* rhs = op_node[1].value();
+
+    if (isInt(lhs) && isInt(rhs))
+    {
+        int32_t result = 0;
+        if (!foldInt(op_type, static_cast<NumberNode*>(lhs)->number.i, static_cast<NumberNode*>(rhs)->number.i, &result))
+        {
+            return false;
+        }
+        replaceNumber(op_node, result);
+        return true;
+    }
+
+    if (isFloat(lhs) && isFloat(rhs))
+    {
+        float result = foldFloat(op_type, static_cast<NumberNode*>(lhs)->number.f, static_cast<NumberNode*>(rhs)->number.f);
+        ast_->replaceValue<NumberNode>(op_node.id(), result);
+        ast_->clearBranches(op_node.id());
+        return true;
+    }
+
+    return false;
+}
+
+bool ASTOptimizer::simplifyIdentity(ASTRef op_node, ASTRef value, ASTRef constant, bool constant_lhs)
+{
+    if (!isInt(constant.value()))
+    {
+        return false;
+    }
+
+    OperationType op_type = static_cast<OperationNode*>(op_node.value())->op_type;
+    int32_t number = static_cast<NumberNode*>(constant.value())->number.i;
+
+    bool add_zero = (op_type == OperationType::ADD) && (number == 0);
+    bool sub_zero = (op_type == OperationType::SUB) && (number == 0) && !constant_lhs;
+    bool mul_one = (op_type == OperationType::MUL) && (number == 1);
+    bool div_one = (op_type == OperationType::DIV) && (number == 1) && !constant_lhs;
+    if (add_zero || sub_zero || mul_one || div_one)
+    {
+        ast_->replaceNode(op_node.id(), value.id());
+        return true;
+    }
+
+    if ((op_type == OperationType::MUL) && (number == 0) && isPure(value))
+    {
+        replaceNumber(op_node, 0);
+        return true;
+    }
+
+    if ((op_type == OperationType::MUL) && (number > 1) && std::has_single_bit(static_cast<uint32_t>(number)))
+    {
+        ast_->replaceValue<NumberNode>(constant.id(), std::countr_zero(static_cast<uint32_t>(number)));
+
+        AST::NodeId shift = ast_->make<OperationNode>(OperationType::SHL);
+        ast_->pushBranch(shift, value.id());
+        ast_->pushBranch(shift, constant.id());
+        ast_->replaceNode(op_node.id(), shift);
+        return true;
+    }
+
+    return false;
+}
+
+void ASTOptimizer::replaceNumber(ASTRef node, int32_t number)
+{
+    ast_->replaceValue<NumberNode>(node.id(), number);
+    ast_->clearBranches(node.id());
+}
+
+bool ASTOptimizer::isPure(ASTRef node)
+{
+    if (node.value()->type() == NodeType::FUNCTION)
+    {
+        return false;
+    }
+    if ((node.value()->type() == NodeType::OPERATION) &&
+        (static_cast<OperationNode*>(node.value())->op_type == OperationType::ASSIGN))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        if (!isPure(node[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "Compiler/Optimizer/Inliner.h"
+
+// Larger bodies are not worth the code growth at every call site.
+static const size_t MAX_INLINE_SIZE = 16;
+
+static bool isOperation(ASTRef node, OperationType op_type)
+{
+    return (node.value()->type() == NodeType::OPERATION) &&
+           (static_cast<OperationNode*>(node.value())->op_type == op_type);
+}
+
+Inliner::Inliner(AST* ast) : ast_(ast) {}
+
+void Inliner::inlineCalls()
+{
+    for (size_t i = 0; i < ast_->branches_num(); i++)
+    {
+        ASTRef class_node = (*ast_)[i];
+        class_ = static_cast<ClassNode*>(class_node.value());
+        class_node_ = class_node.id();
+
+        for (size_t j = 0; j < class_node.branches_num(); j++)
+        {
+            if (class_node[j].value()->type() == NodeType::METHOD)
+            {
+                caller_names_.clear();
+                collectNames(class_node[j], &caller_names_);
+                inlineCalls(class_node[j]);
+            }
+        }
+    }
+}
+
+size_t Inliner::inlined() const
+{
+    return inlined_;
+}
+
+// Arguments are handled before the call that receives them, so nested calls
+// collapse from the inside out. Calls used as statements are kept.
+void Inliner::inlineCalls(ASTRef node)
+{
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        ASTRef branch = node[i];
+        inlineCalls(branch);
+        if ((branch.value()->type() == NodeType::FUNCTION) && (node.value()->type() != NodeType::SCOPE))
+        {
+            inlineCall(branch);
+        }
+    }
+}
+
+bool Inliner::inlineCall(ASTRef call_node)
+{
+    AST::NodeId callee_id = findCallee(static_cast<FunctionNode*>(call_node.value())->name, call_node.branches_num());
+    if (callee_id == AST::NONE)
+    {
+        return false;
+    }
+
+    ASTRef callee(ast_, callee_id);
+    ASTRef scope = callee[callee.branches_num() - 1];
+    if ((scope.branches_num() != 1) || !isOperation(scope[0], OperationType::RETURN) || (scope[0].branches_num() != 1))
+    {
+        return false;
+    }
+
+    ASTRef expr = scope[0][0];
+    size_t size = 0;
+    if (!isLeaf(expr, &size) || (size > MAX_INLINE_SIZE))
+    {
+        return false;
+    }
+
+    std::unordered_map<std::string, AST::NodeId> args;
+    for (size_t i = 0; i < call_node.branches_num(); i++)
+    {
+        args[static_cast<MethodParameterNode*>(callee[i].value())->name] = call_node[i].id();
+    }
+
+    // Names other than parameters are static fields, which a caller local
+    // of the same name would hide.
+    std::unordered_map<std::string, size_t> uses;
+    countUses(expr, &uses);
+    for (const auto& [name, uses_num] : uses)
+    {
+        if (!args.contains(name) && caller_names_.contains(name))
+        {
+            return false;
+        }
+    }
+
+    // An argument that is not a plain variable or number must be evaluated
+    // exactly once, as the call would.
+    for (const auto& [name, arg_id] : args)
+    {
+        ASTRef arg(ast_, arg_id);
+        bool trivial = (arg.value()->type() == NodeType::VARIABLE) || (arg.value()->type() == NodeType::NUMBER);
+        size_t arg_size = 0;
+        if (!trivial && (!uses.contains(name) || (uses[name] != 1) || !isLeaf(arg, &arg_size)))
+        {
+            return false;
+        }
+    }
+
+    AST::NodeId copy = ast_->copyNode(expr.id());
+    substitute(copy, args);
+    ast_->replaceNode(call_node.id(), copy);
+    inlined_++;
+    return true;
+}
+
+void Inliner::substitute(AST::NodeId node, const std::unordered_map<std::string, AST::NodeId>& args)
+{
+    ASTRef ref(ast_, node);
+    if (ref.value()->type() == NodeType::VARIABLE)
+    {
+        auto arg = args.find(static_cast<VariableNode*>(ref.value())->name);
+        if (arg != args.end())
+        {
+            ast_->replaceNode(node, arg->second);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < ref.branches_num(); i++)
+    {
+        substitute(ref[i].id(), args);
+    }
+}
+
+AST::NodeId Inliner::findCallee(const std::string& name, size_t args_num) const
+{
+    ASTRef class_node(ast_, class_node_);
+    for (size_t i = 0; i < class_node.branches_num(); i++)
+    {
+        ASTRef method_node = class_node[i];
+        if (method_node.value()->type() != NodeType::METHOD)
+        {
+            continue;
+        }
+
+        auto* method = static_cast<MethodNode*>(method_node.value());
+        if (((name != method->name) && (name != class_->name + "." + method->name)) ||
+            (method->modifier != MethodType::STATIC) || (method_node.branches_num() != args_num + 1))
+        {
+            continue;
+        }
+
+        bool params = true;
+        for (size_t j = 0; j < args_num; j++)
+        {
+            params = params && (method_node[j].value()->type() == NodeType::MET_PAR);
+        }
+        return params ? method_node.id() : AST::NONE;
+    }
+    return AST::NONE;
+}
+
+bool Inliner::isLeaf(ASTRef node, size_t* size)
+{
+    (*size)++;
+    if ((node.value()->type() == NodeType::FUNCTION) || isOperation(node, OperationType::ASSIGN) ||
+        isOperation(node, OperationType::RETURN))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        if (!isLeaf(node[i], size))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Inliner::countUses(ASTRef node, std::unordered_map<std::string, size_t>* uses)
+{
+    if (node.value()->type() == NodeType::VARIABLE)
+    {
+        (*uses)[static_cast<VariableNode*>(node.value())->name]++;
+    }
+
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        countUses(node[i], uses);
+    }
+}
+
+void Inliner::collectNames(ASTRef node, std::unordered_set<std::string>* names)
+{
+    if (node.value()->type() == NodeType::VAR_DECL)
+    {
+        names->insert(static_cast<VariableDeclarationNode*>(node.value())->name);
+    }
+    else if (node.value()->type() == NodeType::MET_PAR)
+    {
+        names->insert(static_cast<MethodParameterNode*>(node.value())->name);
+    }
+
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        collectNames(node[i], names);
+    }
+}
\ No newline at end of file
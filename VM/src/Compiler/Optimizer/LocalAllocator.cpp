@@ -0,0 +1,221 @@
+#include "Compiler/Optimizer/LocalAllocator.h"
+
+#include <algorithm>
+
+static const uint16_t NO_SLOT = UINT16_MAX;
+
+// IINC both reads and writes its slot.
+static bool writesSlot(Opcode op)
+{
+    return isStore(op) || (op == Opcode::IINC);
+}
+
+static bool readsSlot(Opcode op)
+{
+    return isLoad(op) || (op == Opcode::IINC);
+}
+
+LocalAllocator::LocalAllocator(const std::vector<VariableType>& params)
+{
+    for (auto param : params)
+    {
+        params_.push_back(stackType(param));
+    }
+}
+
+// Returns the number of local slots the rewritten method needs.
+uint16_t LocalAllocator::allocate(std::string* bytecode)
+{
+    Peephole::Code code = Peephole::decode(*bytecode);
+    collectSlots(code);
+
+    std::vector<uint16_t> colors = colorSlots(interference(code));
+    for (auto& instr : code)
+    {
+        if (accessesSlot(instr.op))
+        {
+            instr.arg16 = colors[instr.arg16];
+        }
+    }
+    // Renumbering slots keeps the layout, so every offset still fits.
+    Peephole::encode(code, bytecode);
+
+    size_t locals_num = params_.size();
+    for (uint16_t color : colors)
+    {
+        if (color != NO_SLOT)
+        {
+            locals_num = std::max(locals_num, static_cast<size_t>(color) + 1);
+        }
+    }
+    return static_cast<uint16_t>(locals_num);
+}
+
+void LocalAllocator::collectSlots(const Peephole::Code& code)
+{
+    types_ = params_;
+    for (const auto& instr : code)
+    {
+        if (!accessesSlot(instr.op))
+        {
+            continue;
+        }
+        if (instr.arg16 >= types_.size())
+        {
+            types_.resize(instr.arg16 + 1, VariableType::VOID);
+        }
+        if (types_[instr.arg16] == VariableType::VOID)
+        {
+            types_[instr.arg16] = slotType(instr.op);
+        }
+    }
+}
+
+// Classic backward data flow, iterated until no live set changes.
+void LocalAllocator::liveness(const Peephole::Code& code, std::vector<Slots>* live_in,
+    std::vector<Slots>* live_out) const
+{
+    live_in->assign(code.size(), Slots(types_.size(), false));
+    live_out->assign(code.size(), Slots(types_.size(), false));
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = code.size(); i-- > 0;)
+        {
+            Slots out(types_.size(), false);
+            for (size_t succ : Peephole::successors(code, i))
+            {
+                for (size_t slot = 0; (succ < code.size()) && (slot < out.size()); slot++)
+                {
+                    out[slot] = out[slot] || (*live_in)[succ][slot];
+                }
+            }
+
+            Slots in = out;
+            if (writesSlot(code[i].op))
+            {
+                in[code[i].arg16] = false;
+            }
+            if (readsSlot(code[i].op))
+            {
+                in[code[i].arg16] = true;
+            }
+
+            if ((in != (*live_in)[i]) || (out != (*live_out)[i]))
+            {
+                (*live_in)[i] = std::move(in);
+                (*live_out)[i] = std::move(out);
+                changed = true;
+            }
+        }
+    }
+}
+
+// A slot written while another one is live must not share its storage.
+// Parameters are all written on entry.
+std::vector<LocalAllocator::Slots> LocalAllocator::interference(const Peephole::Code& code) const
+{
+    std::vector<Slots> live_in;
+    std::vector<Slots> live_out;
+    liveness(code, &live_in, &live_out);
+
+    std::vector<Slots> interferes(types_.size(), Slots(types_.size(), false));
+    auto add = [&interferes](size_t def, const Slots& live) {
+        for (size_t slot = 0; slot < live.size(); slot++)
+        {
+            if (live[slot] && (slot != def))
+            {
+                interferes[def][slot] = true;
+                interferes[slot][def] = true;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        if (writesSlot(code[i].op))
+        {
+            add(code[i].arg16, live_out[i]);
+        }
+    }
+
+    Slots entry = live_in.empty() ? Slots(types_.size(), false) : live_in[0];
+    std::fill(entry.begin(), entry.begin() + static_cast<std::ptrdiff_t>(params_.size()), true);
+    for (size_t slot = 0; slot < entry.size(); slot++)
+    {
+        if (entry[slot])
+        {
+            add(slot, entry);
+        }
+    }
+    return interferes;
+}
+
+// Greedy coloring in order of slot numbers, which follows declaration order.
+std::vector<uint16_t> LocalAllocator::colorSlots(const std::vector<Slots>& interferes) const
+{
+    std::vector<uint16_t> colors(types_.size(), NO_SLOT);
+    std::vector<VariableType> color_types;
+    for (size_t slot = 0; slot < params_.size(); slot++)
+    {
+        colors[slot] = static_cast<uint16_t>(slot);
+        color_types.push_back(params_[slot]);
+    }
+
+    for (size_t slot = params_.size(); slot < types_.size(); slot++)
+    {
+        if (types_[slot] == VariableType::VOID)
+        {
+            continue;
+        }
+
+        size_t color = 0;
+        for (; color < color_types.size(); color++)
+        {
+            bool taken = (color_types[color] != types_[slot]);
+            for (size_t other = 0; !taken && (other < types_.size()); other++)
+            {
+                taken = interferes[slot][other] && (colors[other] == color);
+            }
+            if (!taken)
+            {
+                break;
+            }
+        }
+
+        if (color == color_types.size())
+        {
+            color_types.push_back(types_[slot]);
+        }
+        colors[slot] = static_cast<uint16_t>(color);
+    }
+    return colors;
+}
+
+VariableType LocalAllocator::slotType(Opcode op)
+{
+    switch (op)
+    {
+    case Opcode::LLOAD:
+    case Opcode::LSTORE:
+        return VariableType::LONG;
+    case Opcode::FLOAD:
+    case Opcode::FSTORE:
+        return VariableType::FLOAT;
+    case Opcode::DLOAD:
+    case Opcode::DSTORE:
+        return VariableType::DOUBLE;
+    case Opcode::ALOAD:
+    case Opcode::ASTORE:
+        return VariableType::REFERENCE;
+    default:
+        return VariableType::INT;
+    }
+}
+
+bool LocalAllocator::accessesSlot(Opcode op)
+{
+    return readsSlot(op) || writesSlot(op);
+}
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "Compiler/Optimizer/Peephole.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const uint8_t LOAD_TO_STORE = static_cast<uint8_t>(Opcode::ISTORE) - static_cast<uint8_t>(Opcode::ILOAD);
+
+using Code = Peephole::Code;
+
+static bool isBranch(Opcode op)
+{
+    return ((op >= Opcode::IFEQ) && (op <= Opcode::GOTO)) ||
+           ((op >= Opcode::IF_ICMPEQ) && (op <= Opcode::IF_ICMPLE));
+}
+
+static bool isSwitch(Opcode op)
+{
+    return (op == Opcode::TABLESWITCH) || (op == Opcode::LOOKUPSWITCH);
+}
+
+static bool isReturn(Opcode op)
+{
+    return (op >= Opcode::IRETURN) && (op <= Opcode::RETURN);
+}
+
+static bool isSwitchTarget(Opcode op, size_t word)
+{
+    return (word == 0) || ((op == Opcode::TABLESWITCH) && (word >= 2)) ||
+           ((op == Opcode::LOOKUPSWITCH) && (word % 2 == 0));
+}
+
+template<typename Instr, typename F>
+static void forEachTarget(Instr& instr, F func)
+{
+    if (instr.target >= 0)
+    {
+        func(instr.target);
+    }
+    for (size_t word = 0; word < instr.payload.size(); word++)
+    {
+        if (isSwitchTarget(instr.op, word))
+        {
+            func(instr.payload[word]);
+        }
+    }
+}
+
+static Opcode storeOf(Opcode load)
+{
+    return static_cast<Opcode>(static_cast<uint8_t>(load) + LOAD_TO_STORE);
+}
+
+static Peephole::Instruction simple(Opcode op)
+{
+    return {op, 0, 0, -1, {}};
+}
+
+// Follows a chain of GOTOs and returns its final target, or -1 on a cycle.
+static int32_t finalTarget(const Code& code, int32_t target)
+{
+    for (size_t steps = 0; steps < code.size(); steps++)
+    {
+        if (code[static_cast<size_t>(target)].op != Opcode::GOTO)
+        {
+            return target;
+        }
+        target = code[static_cast<size_t>(target)].target;
+    }
+    return -1;
+}
+
+static const std::vector<Peephole::Pattern> PATTERNS = {
+    {
+        // xSTORE n; xLOAD n  ->  DUP; xSTORE n
+        "store_load", 2,
+        [](const Code& code, size_t pos) {
+            return isLoad(code[pos + 1].op) && (storeOf(code[pos + 1].op) == code[pos].op) &&
+                   (code[pos].arg16 == code[pos + 1].arg16);
+        },
+        [](const Code& code, size_t pos) { return Code {simple(Opcode::DUP), code[pos]}; },
+        1,
+    },
+    {
+        // xLOAD n; xLOAD n  ->  xLOAD n; DUP
+        "load_load", 2,
+        [](const Code& code, size_t pos) {
+            return isLoad(code[pos].op) && (code[pos].op == code[pos + 1].op) && (code[pos].arg16 == code[pos + 1].arg16);
+        },
+        [](const Code& code, size_t pos) { return Code {code[pos], simple(Opcode::DUP)}; },
+        0,
+    },
+    {
+        // xLOAD n; xSTORE n  ->  nothing
+        "load_store", 2,
+        [](const Code& code, size_t pos) {
+            return isLoad(code[pos].op) && (storeOf(code[pos].op) == code[pos + 1].op) &&
+                   (code[pos].arg16 == code[pos + 1].arg16);
+        },
+        [](const Code&, size_t) { return Code {}; },
+        0,
+    },
+    {
+        // DUP; xSTORE n; xRETURN  ->  xRETURN, locals die with the frame
+        "dup_store_return", 3,
+        [](const Code& code, size_t pos) {
+            return (code[pos].op == Opcode::DUP) && isStore(code[pos + 1].op) && isReturn(code[pos + 2].op);
+        },
+        [](const Code& code, size_t pos) { return Code {code[pos + 2]}; },
+        0,
+    },
+    {
+        // GOTO next  ->  nothing, IFxx next  ->  POP, IF_ICMPxx next  ->  POP2
+        "jump_to_next", 1,
+        [](const Code& code, size_t pos) {
+            return isBranch(code[pos].op) && (code[pos].target == static_cast<int32_t>(pos + 1));
+        },
+        [](const Code& code, size_t pos) {
+            if (code[pos].op == Opcode::GOTO)
+            {
+                return Code {};
+            }
+            return Code {simple((code[pos].op >= Opcode::IF_ICMPEQ) ? Opcode::POP2 : Opcode::POP)};
+        },
+        0,
+    },
+    {
+        // branch to GOTO L  ->  branch to L
+        "jump_to_jump", 1,
+        [](const Code& code, size_t pos) {
+            if (!isBranch(code[pos].op))
+            {
+                return false;
+            }
+            int32_t target = finalTarget(code, code[pos].target);
+            return (target >= 0) && (target != code[pos].target);
+        },
+        [](const Code& code, size_t pos) {
+            Peephole::Instruction instr = code[pos];
+            instr.target = finalTarget(code, instr.target);
+            return Code {instr};
+        },
+        0,
+    },
+    {
+        // GOTO L; ... L: xRETURN  ->  xRETURN
+        "jump_to_return", 1,
+        [](const Code& code, size_t pos) {
+            return (code[pos].op == Opcode::GOTO) && isReturn(code[static_cast<size_t>(code[pos].target)].op);
+        },
+        [](const Code& code, size_t pos) { return Code {code[static_cast<size_t>(code[pos].target)]}; },
+        0,
+    },
+    {
+        // GOTO, switch or xRETURN followed by an instruction nothing jumps to
+        "unreachable", 2,
+        [](const Code& code, size_t pos) {
+            return (code[pos].op == Opcode::GOTO) || isSwitch(code[pos].op) || isReturn(code[pos].op);
+        },
+        [](const Code& code, size_t pos) { return Code {code[pos]}; },
+        0,
+    },
+};
+
+Peephole::Stats::Stats() : hits_(PATTERNS.size()) {}
+
+void Peephole::Stats::add(size_t pattern)
+{
+    hits_[pattern]++;
+}
+
+size_t Peephole::Stats::hits(size_t pattern) const
+{
+    return hits_[pattern];
+}
+
+void Peephole::Stats::print(std::ostream& os) const
+{
+    for (size_t i = 0; i < PATTERNS.size(); i++)
+    {
+        os << PATTERNS[i].name << ": " << hits_[i] << "\n";
+    }
+}
+
+const std::vector<Peephole::Pattern>& Peephole::patterns()
+{
+    return PATTERNS;
+}
+
+size_t Peephole::pattern(const std::string& name)
+{
+    for (size_t i = 0; i < PATTERNS.size(); i++)
+    {
+        if (name == PATTERNS[i].name)
+        {
+            return i;
+        }
+    }
+    return PATTERNS.size();
+}
+
+Peephole::Peephole(Stats* stats) : stats_(stats) {}
+
+// Returns how many operand stack slots the rewritten code may need on top of
+// the original maximum.
+uint16_t Peephole::optimize(std::string* bytecode)
+{
+    Code code = decode(*bytecode);
+    stack_growth_ = 0;
+
+    auto find_targets = [](const Code& code) {
+        std::vector<bool> targets(code.size() + 1, false);
+        for (const auto& instr : code)
+        {
+            forEachTarget(instr, [&targets](int32_t target) { targets[static_cast<size_t>(target)] = true; });
+        }
+        return targets;
+    };
+
+    std::vector<bool> targets = find_targets(code);
+    size_t pos = 0;
+    while (pos < code.size())
+    {
+        if (applyPattern(&code, pos, targets))
+        {
+            targets = find_targets(code);
+            pos = (pos > 2) ? pos - 2 : 0;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    // Threaded jumps may outgrow a 16-bit offset; the input already fits.
+    if (!encode(code, bytecode))
+    {
+        return 0;
+    }
+    return stack_growth_;
+}
+
+std::vector<size_t> Peephole::successors(const Code& code, size_t pos)
+{
+    std::vector<size_t> succ;
+    forEachTarget(code[pos], [&succ](int32_t target) { succ.push_back(static_cast<size_t>(target)); });
+
+    Opcode op = code[pos].op;
+    if ((op != Opcode::GOTO) && !isSwitch(op) && !isReturn(op) && (pos + 1 < code.size()))
+    {
+        succ.push_back(pos + 1);
+    }
+    return succ;
+}
+
+// Switches span several words, so byte offsets are mapped to instruction
+// indices through the start position of every instruction.
+Code Peephole::decode(const std::string& bytecode)
+{
+    std::vector<size_t> starts;
+    for (size_t pos = 0; pos + INSTRUCTION_SIZE <= bytecode.size(); pos += instructionSize(&bytecode[pos]))
+    {
+        starts.push_back(pos);
+    }
+    auto index = [&starts](size_t pos, int32_t offset) {
+        auto target = static_cast<size_t>(static_cast<int64_t>(pos) + offset);
+        return static_cast<int32_t>(std::lower_bound(starts.begin(), starts.end(), target) - starts.begin());
+    };
+
+    Code code;
+    for (size_t pos : starts)
+    {
+        Instruction instr = {static_cast<Opcode>(static_cast<uint8_t>(bytecode[pos])),
+            static_cast<uint8_t>(bytecode[pos + 1]), 0, -1, {}};
+        std::memcpy(&instr.arg16, &bytecode[pos + 2], sizeof(instr.arg16));
+
+        if (isBranch(instr.op))
+        {
+            instr.target = index(pos, static_cast<int16_t>(instr.arg16));
+        }
+        else if (isSwitch(instr.op))
+        {
+            instr.payload.resize(instructionSize(&bytecode[pos]) / INSTRUCTION_SIZE - 1);
+            std::memcpy(instr.payload.data(), &bytecode[pos + INSTRUCTION_SIZE],
+                instr.payload.size() * sizeof(int32_t));
+            for (size_t word = 0; word < instr.payload.size(); word++)
+            {
+                if (isSwitchTarget(instr.op, word))
+                {
+                    instr.payload[word] = index(pos, instr.payload[word]);
+                }
+            }
+        }
+        code.push_back(std::move(instr));
+    }
+    return code;
+}
+
+// Leaves bytecode untouched if a branch offset does not fit in 16 bits.
+bool Peephole::encode(const Code& code, std::string* bytecode)
+{
+    std::vector<int32_t> starts(code.size() + 1, 0);
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        starts[i + 1] = starts[i] + static_cast<int32_t>(INSTRUCTION_SIZE * (1 + code[i].payload.size()));
+    }
+
+    std::string result(static_cast<size_t>(starts.back()), '\0');
+    for (size_t i = 0; i < code.size(); i++)
+    {
+        Instruction instr = code[i];
+        bool branch = (instr.target >= 0);
+        forEachTarget(instr, [&starts, i](int32_t& target) {
+            target = starts[static_cast<size_t>(target)] - starts[i];
+        });
+        if (branch)
+        {
+            if (instr.target < INT16_MIN || instr.target > INT16_MAX)
+            {
+                return false;
+            }
+            instr.arg16 = static_cast<uint16_t>(static_cast<int16_t>(instr.target));
+        }
+
+        auto pos = static_cast<size_t>(starts[i]);
+        result[pos] = static_cast<char>(instr.op);
+        result[pos + 1] = static_cast<char>(instr.arg8);
+        std::memcpy(&result[pos + 2], &instr.arg16, sizeof(instr.arg16));
+        if (!instr.payload.empty())
+        {
+            std::memcpy(&result[pos + INSTRUCTION_SIZE], instr.payload.data(),
+                instr.payload.size() * sizeof(int32_t));
+        }
+    }
+    *bytecode = std::move(result);
+    return true;
+}
+
+// A window may only be entered through its first instruction.
+bool Peephole::applyPattern(Code* code, size_t pos, const std::vector<bool>& targets)
+{
+    for (size_t i = 0; i < PATTERNS.size(); i++)
+    {
+        const Pattern& pattern = PATTERNS[i];
+        if (pos + pattern.length > code->size())
+        {
+            continue;
+        }
+
+        bool entered = false;
+        for (size_t j = pos + 1; j < pos + pattern.length; j++)
+        {
+            entered = entered || targets[j];
+        }
+        if (entered || !pattern.match(*code, pos))
+        {
+            continue;
+        }
+
+        Code replacement = pattern.rewrite(*code, pos);
+        auto removed = static_cast<int32_t>(pattern.length - replacement.size());
+        auto end = static_cast<int32_t>(pos + pattern.length);
+
+        code->erase(code->begin() + static_cast<std::ptrdiff_t>(pos),
+            code->begin() + static_cast<std::ptrdiff_t>(pos + pattern.length));
+        code->insert(code->begin() + static_cast<std::ptrdiff_t>(pos), replacement.begin(), replacement.end());
+        for (auto& instr : *code)
+        {
+            forEachTarget(instr, [end, removed](int32_t& target) {
+                if (target >= end)
+                {
+                    target -= removed;
+                }
+            });
+        }
+
+        stack_growth_ = std::max(stack_growth_, pattern.stack_growth);
+        if (stats_)
+        {
+            stats_->add(i);
+        }
+        return true;
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "Compiler/Report/TimeReport.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sys/resource.h>
+
+// Plain thread_local integers need no initialization call, so operator new
+// may update them at any point of a thread's life.
+static thread_local uint64_t thread_allocations = 0;
+static thread_local uint64_t thread_allocated_bytes = 0;
+
+static long peakRss()
+{
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+TimeReport::Scope::Scope(TimeReport* report, const char* name) : report_(report), name_(name)
+{
+    if (report_)
+    {
+        allocations_ = thread_allocations;
+        allocated_bytes_ = thread_allocated_bytes;
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+TimeReport::Scope::~Scope()
+{
+    end();
+}
+
+void TimeReport::Scope::end()
+{
+    if (report_)
+    {
+        std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start_;
+        report_->phases.push_back({name_, ms.count(), thread_allocations - allocations_,
+            thread_allocated_bytes - allocated_bytes_, peakRss()});
+        report_ = nullptr;
+    }
+}
+
+void TimeReport::countAllocation(size_t bytes)
+{
+    thread_allocations++;
+    thread_allocated_bytes += bytes;
+}
+
+double TimeReport::totalMs() const
+{
+    double total = 0;
+    for (const auto& phase : phases)
+    {
+        total += phase.ms;
+    }
+    return total;
+}
+
+static void printHeader(std::ostream& os)
+{
+    os << "  " << std::left << std::setw(12) << "phase" << std::right << std::setw(12) << "wall ms" << std::setw(12)
+       << "allocs" << std::setw(14) << "alloc KiB" << std::setw(14) << "peak RSS KiB" << "\n";
+}
+
+static void printPhase(std::ostream& os, const TimeReport::Phase& phase)
+{
+    os << "  " << std::left << std::setw(12) << phase.name << std::right << std::fixed << std::setprecision(3)
+       << std::setw(12) << phase.ms << std::setw(12) << phase.allocations << std::setw(14)
+       << (phase.allocated_bytes + 1023) / 1024 << std::setw(14) << phase.peak_rss_kb << "\n";
+}
+
+void TimeReport::print(std::ostream& os) const
+{
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << "Time report: " << file_name << "\n";
+    printHeader(os);
+    Phase total = {"total", 0, 0, 0, 0};
+    for (const auto& phase : phases)
+    {
+        printPhase(os, phase);
+        total.ms += phase.ms;
+        total.allocations += phase.allocations;
+        total.allocated_bytes += phase.allocated_bytes;
+        total.peak_rss_kb = std::max(total.peak_rss_kb, phase.peak_rss_kb);
+    }
+    printPhase(os, total);
+
+    if (parsed_nodes)
+    {
+        os << "  AST nodes: " << parsed_nodes << " parsed, " << optimized_nodes << " after optimization\n";
+    }
+    for (const auto& [class_name, constants] : constant_pools)
+    {
+        os << "  Constant pool: " << class_name << " " << constants << " entries\n";
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void TimeReport::print(std::ostream& os, const std::vector<const TimeReport*>& reports)
+{
+    std::vector<const TimeReport*> slowest(reports);
+    std::stable_sort(slowest.begin(), slowest.end(), [](const TimeReport* a, const TimeReport* b) {
+        return a->totalMs() > b->totalMs();
+    });
+    for (const TimeReport* report : slowest)
+    {
+        report->print(os);
+    }
+    if (reports.size() < 2)
+    {
+        return;
+    }
+
+    TimeReport total;
+    total.file_name = "all files";
+    for (const TimeReport* report : reports)
+    {
+        for (const auto& phase : report->phases)
+        {
+            auto it = std::find_if(total.phases.begin(), total.phases.end(), [&phase](const Phase& other) {
+                return std::string(other.name) == phase.name;
+            });
+            if (it == total.phases.end())
+            {
+                total.phases.push_back(phase);
+                continue;
+            }
+            it->ms += phase.ms;
+            it->allocations += phase.allocations;
+            it->allocated_bytes += phase.allocated_bytes;
+            it->peak_rss_kb = std::max(it->peak_rss_kb, phase.peak_rss_kb);
+        }
+        total.parsed_nodes += report->parsed_nodes;
+        total.optimized_nodes += report->optimized_nodes;
+    }
+    total.print(os);
+}
\ No newline at end of file
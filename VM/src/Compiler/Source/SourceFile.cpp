@@ -0,0 +1,80 @@
+#include "Compiler/Source/SourceFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::SourceFile(const std::string& file_name)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat st = {};
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode))
+    {
+        size_ = static_cast<size_t>(st.st_size);
+        opened_ = true;
+        if (size_ != 0)
+        {
+            region_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (region_ == MAP_FAILED)
+            {
+                region_ = nullptr;
+                size_ = 0;
+                opened_ = false;
+            }
+        }
+    }
+    close(fd);
+}
+
+SourceFile::~SourceFile()
+{
+    if (region_)
+    {
+        munmap(region_, size_);
+    }
+}
+
+bool SourceFile::is_open() const
+{
+    return opened_;
+}
+
+const char* SourceFile::data() const
+{
+    return static_cast<const char*>(region_);
+}
+
+size_t SourceFile::size() const
+{
+    return size_;
+}
+
+std::string_view SourceFile::line(size_t lineno) const
+{
+    if (line_starts_.empty())
+    {
+        line_starts_.push_back(0);
+        for (size_t i = 0; i < size_; i++)
+        {
+            if (data()[i] == '\n')
+            {
+                line_starts_.push_back(i + 1);
+            }
+        }
+    }
+
+    if ((lineno == 0) || (lineno > line_starts_.size()))
+    {
+        return {};
+    }
+
+    size_t begin = line_starts_[lineno - 1];
+    size_t end = (lineno < line_starts_.size()) ? line_starts_[lineno] - 1 : size_;
+    return {data() + begin, end - begin};
+}
\ No newline at end of file
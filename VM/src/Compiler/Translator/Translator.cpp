@@ -1,12 +1,80 @@
 #include "Compiler/Translator/Translator.h"
+#include "Compiler/Optimizer/LocalAllocator.h"
 #include "Opcodes.h"
 
-Translator::Translator(AST* ast) : ast_(ast) {}
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Shorter chains are as cheap as a compare sequence.
+static const size_t MIN_SWITCH_CASES = 3;
+
+static bool isControl(ASTRef node, ControlType control_type)
+{
+    return (node.value()->type() == NodeType::CONTROL) &&
+           (static_cast<ControlNode*>(node.value())->control_type == control_type);
+}
+
+// Index of the comparison among IFEQ, IFNE, IFLT, IFGE, IFGT, IFLE. The
+// negation of a condition is the neighbouring index.
+static uint8_t conditionIndex(OperationType op_type)
+{
+    switch (op_type)
+    {
+    case OperationType::EQ: return 0;
+    case OperationType::NEQ: return 1;
+    case OperationType::STL: return 2;
+    case OperationType::GEQ: return 3;
+    case OperationType::STG: return 4;
+    default: return 5;
+    }
+}
+
+// Matches `name == key` and `key == name` for an int constant key.
+static bool switchCase(ASTRef cond_node, std::string* name, int32_t* key)
+{
+    if ((cond_node.value()->type() != NodeType::OPERATION) ||
+        (static_cast<OperationNode*>(cond_node.value())->op_type != OperationType::EQ))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        ASNode* var = cond_node[i].value();
+        ASNode* num = cond_node[1 - i].value();
+        if ((var->type() == NodeType::VARIABLE) && (num->type() == NodeType::NUMBER) &&
+            (static_cast<NumberNode*>(num)->num_type == VariableType::INT))
+        {
+            *name = static_cast<VariableNode*>(var)->name;
+            *key = static_cast<NumberNode*>(num)->number.i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool testCondition(uint8_t cond, int32_t cmp)
+{
+    switch (cond)
+    {
+    case 0: return cmp == 0;
+    case 1: return cmp != 0;
+    case 2: return cmp < 0;
+    case 3: return cmp >= 0;
+    case 4: return cmp > 0;
+    default: return cmp <= 0;
+    }
+}
+
+Translator::Translator(AST* ast, size_t class_num, Peephole::Stats* opt_stats) :
+    ast_(ast), class_num_(class_num), opt_stats_(opt_stats)
+{}
 
 void Translator::translate(std::ofstream* file)
 {
-    auto* class_node = static_cast<AST*>(&((*ast_)[0]));
-    std::string class_name = static_cast<ClassNode*>(class_node->value().get())->name;
+    ASTRef class_node = (*ast_)[class_num_];
+    std::string class_name = static_cast<ClassNode*>(class_node.value())->name;
     file->write(class_name.c_str(), static_cast<std::streamsize>(class_name.length() + 1));
 
     std::stringstream class_content;
@@ -20,6 +88,21 @@ void Translator::translate(std::ofstream* file)
     *file << instructions.str();
 }
 
+size_t Translator::constants() const
+{
+    return const_pool_.size();
+}
+
+std::vector<std::string>* Translator::getErrors()
+{
+    return &errors_;
+}
+
+bool Translator::err() const
+{
+    return !errors_.empty();
+}
+
 void Translator::writeConstantPool(std::ofstream* file)
 {
     auto cp_size = static_cast<uint16_t>(const_pool_.size());
@@ -62,50 +145,58 @@ void Translator::writeConstantPool(std::ofstream* file)
     }
 }
 
-void Translator::writeFields(AST* class_node, std::stringstream* class_content)
+void Translator::writeFields(ASTRef class_node, std::stringstream* class_content)
 {
     uint8_t fields_num = 0;
-    for (size_t i = 0; i < class_node->branches_num(); i++)
+    for (size_t i = 0; i < class_node.branches_num(); i++)
     {
-        if ((*class_node)[i].value()->type() == NodeType::FIELD)
+        if (class_node[i].value()->type() == NodeType::FIELD)
         {
             fields_num++;
         }
     }
     class_content->write(reinterpret_cast<char*>(&fields_num), sizeof(fields_num));
 
-    for (size_t i = 0; i < class_node->branches_num(); i++)
+    for (size_t i = 0; i < class_node.branches_num(); i++)
     {
-        if ((*class_node)[i].value()->type() == NodeType::FIELD)
+        if (class_node[i].value()->type() == NodeType::FIELD)
         {
-            auto* field_node = static_cast<FieldNode*>((*class_node)[i].value().get());
+            auto* field_node = static_cast<FieldNode*>(class_node[i].value());
             class_content->write(reinterpret_cast<char*>(&field_node->access_type), 1);
+            class_content->write(reinterpret_cast<char*>(&field_node->modifier), 1);
             class_content->write(reinterpret_cast<char*>(&field_node->var_type), 1);
 
             auto cp_size = static_cast<uint16_t>(const_pool_.size());
             class_content->write(reinterpret_cast<char*>(&cp_size), sizeof(cp_size));
             const_pool_[std::make_unique<StringType>(StringType(field_node->name))] = cp_size;
+
+            if (field_node->modifier == FieldType::STATIC)
+            {
+                statics_[field_node->name] = field_node->var_type;
+            }
         }
     }
 }
 
-void Translator::writeMethods(AST* class_node, std::stringstream* class_content, std::stringstream* instructions)
+void Translator::writeMethods(ASTRef class_node, std::stringstream* class_content, std::stringstream* instructions)
 {
     uint8_t methods_num = 0;
-    for (size_t i = 0; i < class_node->branches_num(); i++)
+    for (size_t i = 0; i < class_node.branches_num(); i++)
     {
-        if ((*class_node)[i].value()->type() == NodeType::METHOD)
+        if (class_node[i].value()->type() == NodeType::METHOD)
         {
             methods_num++;
+            auto* method_node = static_cast<MethodNode*>(class_node[i].value());
+            methods_[method_node->name] = method_node->ret_type;
         }
     }
     class_content->write(reinterpret_cast<char*>(&methods_num), sizeof(methods_num));
 
-    for (size_t i = 0; i < class_node->branches_num(); i++)
+    for (size_t i = 0; i < class_node.branches_num(); i++)
     {
-        if ((*class_node)[i].value()->type() == NodeType::METHOD)
+        if (class_node[i].value()->type() == NodeType::METHOD)
         {
-            auto* method_node = static_cast<MethodNode*>((*class_node)[i].value().get());
+            auto* method_node = static_cast<MethodNode*>(class_node[i].value());
             class_content->write(reinterpret_cast<char*>(&method_node->access_type), 1);
             class_content->write(reinterpret_cast<char*>(&method_node->modifier), 1);
             class_content->write(reinterpret_cast<char*>(&method_node->ret_type), 1);
@@ -114,115 +205,445 @@ void Translator::writeMethods(AST* class_node, std::stringstream* class_content,
             class_content->write(reinterpret_cast<char*>(&cp_size), sizeof(cp_size));
             const_pool_[std::make_unique<StringType>(StringType(method_node->name))] = cp_size;
             
+            method_name_ = static_cast<ClassNode*>(class_node.value())->name + "." + method_node->name;
             locals_.clear();
-            writeMethodParams(static_cast<AST*>(&((*class_node)[i])), class_content);
+            params_.clear();
+            next_local_ = 0;
+            labels_.clear();
+            stack_size_ = 0;
+            max_stack_ = 0;
+            writeMethodParams(class_node[i], class_content);
+
+            ASTRef scope_node = class_node[i][class_node[i].branches_num() - 1];
+            std::stringstream method_code;
+            writeInstructions(scope_node, &method_code);
 
-            auto* scope_node = static_cast<AST*>(&(*class_node)[i][(*class_node)[i].branches_num() - 1]);
-            uint32_t offset = writeInstructions(scope_node, instructions);
+            uint32_t null = 0;
+            auto op_code = static_cast<uint8_t>(Opcode::RETURN);
+            method_code.write(reinterpret_cast<char*>(&op_code), 1);
+            method_code.write(reinterpret_cast<char*>(&null), 3);
+
+            std::string code = method_code.str();
+            uint16_t locals_num = next_local_;
+            if (resolveLabels(&code))
+            {
+                Peephole peephole(opt_stats_);
+                max_stack_ += peephole.optimize(&code);
+                LocalAllocator local_allocator(params_);
+                locals_num = local_allocator.allocate(&code);
+            }
+            else
+            {
+                errors_.push_back("error: branch offset out of range in " + method_name_);
+            }
+
+            auto offset = static_cast<uint32_t>(instructions->tellp());
             class_content->write(reinterpret_cast<char*>(&offset), sizeof(offset));
 
-            auto locals_num = static_cast<uint16_t>(locals_.size());
             class_content->write(reinterpret_cast<char*>(&locals_num), sizeof(locals_num));
+            class_content->write(reinterpret_cast<char*>(&max_stack_), sizeof(max_stack_));
 
-            uint32_t null = 0;
-            auto op_code = static_cast<uint8_t>(Opcode::RETURN);
-            instructions->write(reinterpret_cast<char*>(&op_code), 1);
-            instructions->write(reinterpret_cast<char*>(&null), 3);
+            instructions->write(code.data(), static_cast<std::streamsize>(code.size()));
         }
     }
 }
 
-void Translator::writeMethodParams(AST* method_node, std::stringstream* class_content)
+void Translator::writeMethodParams(ASTRef method_node, std::stringstream* class_content)
 {
     uint8_t mps_num = 0;
-    for (size_t i = 0; i < method_node->branches_num(); i++)
+    for (size_t i = 0; i < method_node.branches_num(); i++)
     {
-        if ((*method_node)[i].value()->type() == NodeType::MET_PAR)
+        if (method_node[i].value()->type() == NodeType::MET_PAR)
         {
             mps_num++;
         }
     }
     class_content->write(reinterpret_cast<char*>(&mps_num), sizeof(mps_num));
 
-    for (size_t i = 0; i < method_node->branches_num(); i++)
+    for (size_t i = 0; i < method_node.branches_num(); i++)
     {
-        if ((*method_node)[i].value()->type() == NodeType::MET_PAR)
+        if (method_node[i].value()->type() == NodeType::MET_PAR)
         {
-            auto* mp_node = static_cast<MethodParameterNode*>((*method_node)[i].value().get());
+            auto* mp_node = static_cast<MethodParameterNode*>(method_node[i].value());
             class_content->write(reinterpret_cast<char*>(&mp_node->var_type), 1);
 
-            auto locals_size = static_cast<uint16_t>(locals_.size());
-            locals_[mp_node->name] = std::make_pair(locals_size, mp_node->var_type);
+            locals_[mp_node->name] = std::make_pair(next_local_++, mp_node->var_type);
+            params_.push_back(mp_node->var_type);
         }
     }
 }
 
+// Every declaration gets a slot of its own, LocalAllocator packs them later.
 void Translator::appendLocal(VariableDeclarationNode* var_decl_node)
 {
-    auto locals_size = static_cast<uint16_t>(locals_.size());
-    locals_[var_decl_node->name] = std::make_pair(locals_size, var_decl_node->var_type);
+    locals_[var_decl_node->name] = std::make_pair(next_local_++, var_decl_node->var_type);
 }
 
-uint32_t Translator::writeInstructions(AST* scope_node, std::stringstream* instructions)
+uint32_t Translator::writeInstructions(ASTRef scope_node, std::stringstream* instructions)
 {
-    auto offset = static_cast<uint32_t>(instructions->tellg());
-    for (size_t i = 0; i < scope_node->branches_num(); i++)
+    auto offset = static_cast<uint32_t>(instructions->tellp());
+    auto outer_locals = locals_;
+    for (size_t i = 0; i < scope_node.branches_num(); i++)
     {
-        switch ((*scope_node)[i].value()->type())
+        switch (scope_node[i].value()->type())
         {
         case NodeType::SCOPE:
-            writeInstructions(static_cast<AST*>(&(*scope_node)[i]), instructions);
+            writeInstructions(scope_node[i], instructions);
             break;
         case NodeType::OPERATION:
-            writeOperation(static_cast<AST*>(&(*scope_node)[i]), instructions);
+            writeOperation(scope_node[i], instructions);
             break;
         case NodeType::FUNCTION:
-            writeFunction(static_cast<AST*>(&(*scope_node)[i]), instructions);
+            // A discarded result would leave paths that meet at a label with different stack depths.
+            if (writeFunction(scope_node[i], instructions) != VariableType::VOID)
+            {
+                writeOpcode(Opcode::POP, instructions);
+                popStack();
+            }
             break;
         case NodeType::VAR_DECL:
-            appendLocal(static_cast<VariableDeclarationNode*>((*scope_node)[i].value().get()));
+            appendLocal(static_cast<VariableDeclarationNode*>(scope_node[i].value()));
+            break;
+        case NodeType::CONTROL:
+            if (isControl(scope_node[i], ControlType::WHILE))
+            {
+                writeWhile(scope_node[i], instructions);
+            }
+            else
+            {
+                writeIf(scope_node, &i, instructions);
+            }
             break;
         default:
             break;
         }
     }
+
+    // Names declared in the scope go out of view when it ends.
+    locals_ = std::move(outer_locals);
     return offset;
 }
 
-VariableType Translator::writeObject(AST* obj_node, std::stringstream* instructions)
+// Lowers an if statement together with the elif and else arms that follow it
+// in the same scope. Each failed condition jumps straight to the next arm.
+void Translator::writeIf(ASTRef scope_node, size_t* ind, std::stringstream* instructions)
 {
-    switch (obj_node->value()->type())
+    if (!isControl(scope_node[*ind], ControlType::IF))
+    {
+        errors_.push_back("error: else/elif without if in " + method_name_);
+        return;
+    }
+
+    size_t last = *ind;
+    while ((last + 1 < scope_node.branches_num()) && isControl(scope_node[last + 1], ControlType::ELIF))
+    {
+        last++;
+    }
+    if ((last + 1 < scope_node.branches_num()) && isControl(scope_node[last + 1], ControlType::ELSE))
+    {
+        last++;
+    }
+
+    if (writeSwitch(scope_node, *ind, last, instructions))
+    {
+        *ind = last;
+        return;
+    }
+
+    size_t end = newLabel();
+    for (size_t i = *ind; i <= last; i++)
+    {
+        ASTRef arm = scope_node[i];
+        if (isControl(arm, ControlType::ELSE))
+        {
+            writeInstructions(arm[0], instructions);
+            break;
+        }
+
+        size_t next = newLabel();
+        writeCondition(arm[0], false, next, instructions);
+        writeInstructions(arm[1], instructions);
+        if (i < last)
+        {
+            writeBranch(Opcode::GOTO, end, instructions);
+        }
+        bindLabel(next, instructions);
+    }
+    bindLabel(end, instructions);
+
+    *ind = last;
+}
+
+// A chain whose arms all compare one int variable with distinct constants
+// dispatches in one step: through a jump table indexed by the key when the
+// keys are dense, through a sorted table searched by the interpreter otherwise.
+bool Translator::writeSwitch(ASTRef scope_node, size_t first, size_t last, std::stringstream* instructions)
+{
+    bool has_else = isControl(scope_node[last], ControlType::ELSE);
+    size_t cases_num = last - first + (has_else ? 0 : 1);
+    if ((cases_num < MIN_SWITCH_CASES) || (cases_num > UINT16_MAX))
+    {
+        return false;
+    }
+
+    std::string subject;
+    std::vector<std::pair<int32_t, size_t>> keys;
+    for (size_t i = 0; i < cases_num; i++)
+    {
+        std::string name;
+        int32_t key = 0;
+        if (!switchCase(scope_node[first + i][0], &name, &key) || (!subject.empty() && (name != subject)))
+        {
+            return false;
+        }
+        subject = name;
+        keys.emplace_back(key, i);
+    }
+
+    VariableType var_type = VariableType::VOID;
+    if (locals_.contains(subject))
+    {
+        var_type = locals_[subject].second;
+    }
+    else if (statics_.contains(subject))
+    {
+        var_type = statics_[subject];
+    }
+    if ((var_type != VariableType::INT) && (var_type != VariableType::SHORT) && (var_type != VariableType::CHAR) &&
+        (var_type != VariableType::BYTE))
+    {
+        return false;
+    }
+
+    std::sort(keys.begin(), keys.end());
+    for (size_t i = 1; i < keys.size(); i++)
+    {
+        if (keys[i].first == keys[i - 1].first)
+        {
+            return false;
+        }
+    }
+
+    int64_t range = static_cast<int64_t>(keys.back().first) - keys.front().first + 1;
+    bool dense = (range <= static_cast<int64_t>(2 * cases_num)) && (range <= UINT16_MAX);
+
+    std::vector<size_t> arms;
+    for (size_t i = 0; i < cases_num; i++)
+    {
+        arms.push_back(newLabel());
+    }
+    size_t end = newLabel();
+    size_t other = has_else ? newLabel() : end;
+
+    writeLoad(subject, instructions);
+    auto switch_pos = static_cast<uint32_t>(instructions->tellp());
+    auto op_code = static_cast<uint8_t>(dense ? Opcode::TABLESWITCH : Opcode::LOOKUPSWITCH);
+    uint8_t null = 0;
+    auto num = static_cast<uint16_t>(dense ? range : static_cast<int64_t>(cases_num));
+    instructions->write(reinterpret_cast<char*>(&op_code), 1);
+    instructions->write(reinterpret_cast<char*>(&null), 1);
+    instructions->write(reinterpret_cast<char*>(&num), 2);
+    popStack();
+
+    writeSwitchTarget(other, switch_pos, instructions);
+    if (dense)
+    {
+        int32_t low = keys.front().first;
+        instructions->write(reinterpret_cast<char*>(&low), sizeof(low));
+        size_t next = 0;
+        for (int64_t key = low; key <= keys.back().first; key++)
+        {
+            bool hit = (keys[next].first == key);
+            writeSwitchTarget(hit ? arms[keys[next].second] : other, switch_pos, instructions);
+            next += hit ? 1 : 0;
+        }
+    }
+    else
+    {
+        for (auto& [key, arm] : keys)
+        {
+            instructions->write(reinterpret_cast<char*>(&key), sizeof(key));
+            writeSwitchTarget(arms[arm], switch_pos, instructions);
+        }
+    }
+
+    for (size_t i = first; i <= last; i++)
+    {
+        if (isControl(scope_node[i], ControlType::ELSE))
+        {
+            bindLabel(other, instructions);
+            writeInstructions(scope_node[i][0], instructions);
+            break;
+        }
+
+        bindLabel(arms[i - first], instructions);
+        writeInstructions(scope_node[i][1], instructions);
+        if (i < last)
+        {
+            writeBranch(Opcode::GOTO, end, instructions);
+        }
+    }
+    bindLabel(end, instructions);
+
+    return true;
+}
+
+// Loops are rotated: the condition sits below the body, so every iteration
+// executes a single conditional branch.
+void Translator::writeWhile(ASTRef while_node, std::stringstream* instructions)
+{
+    size_t body = newLabel();
+    size_t cond = newLabel();
+
+    writeBranch(Opcode::GOTO, cond, instructions);
+    bindLabel(body, instructions);
+    writeInstructions(while_node[1], instructions);
+    bindLabel(cond, instructions);
+    writeCondition(while_node[0], true, body, instructions);
+}
+
+// Emits a jump to label taken when the condition evaluates to jump_if.
+// Integer comparisons fuse into IF_ICMPxx, && and || short-circuit.
+void Translator::writeCondition(ASTRef cond_node, bool jump_if, size_t label, std::stringstream* instructions)
+{
+    if (cond_node.value()->type() == NodeType::NUMBER)
+    {
+        auto* num_node = static_cast<NumberNode*>(cond_node.value());
+        bool value = (num_node->num_type == VariableType::FLOAT) ? (num_node->number.f != 0)
+                                                                 : (num_node->number.i != 0);
+        if (value == jump_if)
+        {
+            writeBranch(Opcode::GOTO, label, instructions);
+        }
+        return;
+    }
+
+    OperationType op_type = OperationType::ASSIGN;
+    if (cond_node.value()->type() == NodeType::OPERATION)
+    {
+        op_type = static_cast<OperationNode*>(cond_node.value())->op_type;
+    }
+
+    switch (op_type)
+    {
+    case OperationType::AND:
+    case OperationType::OR:
+    {
+        if (jump_if == (op_type == OperationType::OR))
+        {
+            writeCondition(cond_node[0], jump_if, label, instructions);
+            writeCondition(cond_node[1], jump_if, label, instructions);
+        }
+        else
+        {
+            size_t skip = newLabel();
+            writeCondition(cond_node[0], !jump_if, skip, instructions);
+            writeCondition(cond_node[1], jump_if, label, instructions);
+            bindLabel(skip, instructions);
+        }
+        return;
+    }
+    case OperationType::EQ:
+    case OperationType::NEQ:
+    case OperationType::LEQ:
+    case OperationType::GEQ:
+    case OperationType::STL:
+    case OperationType::STG:
+    {
+        VariableType type = writeObject(cond_node[1], instructions);
+        writeObject(cond_node[0], instructions);
+
+        uint8_t cond = conditionIndex(op_type) ^ (jump_if ? 0 : 1);
+        if ((type != VariableType::LONG) && (type != VariableType::FLOAT) && (type != VariableType::DOUBLE))
+        {
+            writeBranch(static_cast<Opcode>(static_cast<uint8_t>(Opcode::IF_ICMPEQ) + cond), label, instructions);
+            popStack(2);
+            return;
+        }
+
+        // NaN must make every comparison but != false, so pick the variant
+        // whose unordered result steers the jump that way.
+        bool nan_jump = (op_type == OperationType::NEQ) == jump_if;
+        bool less = testCondition(cond, -1) == nan_jump;
+        if (type == VariableType::LONG)
+        {
+            writeOpcode(Opcode::LCMP, instructions);
+        }
+        else if (type == VariableType::FLOAT)
+        {
+            writeOpcode(less ? Opcode::FCMPL : Opcode::FCMPG, instructions);
+        }
+        else
+        {
+            writeOpcode(less ? Opcode::DCMPL : Opcode::DCMPG, instructions);
+        }
+        popStack();
+
+        writeBranch(static_cast<Opcode>(static_cast<uint8_t>(Opcode::IFEQ) + cond), label, instructions);
+        popStack();
+        return;
+    }
+    default:
+        writeObject(cond_node, instructions);
+        writeBranch(jump_if ? Opcode::IFNE : Opcode::IFEQ, label, instructions);
+        popStack();
+        return;
+    }
+}
+
+VariableType Translator::writeComparison(ASTRef op_node, std::stringstream* instructions)
+{
+    size_t is_false = newLabel();
+    size_t end = newLabel();
+    NumberNode one(1);
+    NumberNode zero(0);
+
+    writeCondition(op_node, false, is_false, instructions);
+    writeNumber(&one, instructions);
+    writeBranch(Opcode::GOTO, end, instructions);
+    popStack();
+
+    bindLabel(is_false, instructions);
+    writeNumber(&zero, instructions);
+    bindLabel(end, instructions);
+
+    return VariableType::INT;
+}
+
+VariableType Translator::writeObject(ASTRef obj_node, std::stringstream* instructions)
+{
+    switch (obj_node.value()->type())
     {
     case NodeType::OPERATION:
         return writeOperation(obj_node, instructions);
     case NodeType::FUNCTION:
         return writeFunction(obj_node, instructions);
     case NodeType::VARIABLE:
-        return writeLoad(static_cast<VariableNode*>(obj_node->value().get())->name, instructions);
+        return writeLoad(static_cast<VariableNode*>(obj_node.value())->name, instructions);
     case NodeType::NUMBER:
-        return writeNumber(static_cast<NumberNode*>(obj_node->value().get()), instructions);
+        return writeNumber(static_cast<NumberNode*>(obj_node.value()), instructions);
     default:
         break;
     }
     return VariableType::VOID;
 }
 
-VariableType Translator::writeOperation(AST* op_node, std::stringstream* instructions)
+VariableType Translator::writeOperation(ASTRef op_node, std::stringstream* instructions)
 {
-    switch (static_cast<OperationNode*>(op_node->value().get())->op_type)
+    switch (static_cast<OperationNode*>(op_node.value())->op_type)
     {
     case OperationType::ADD:
     case OperationType::SUB:
     case OperationType::MUL:
     case OperationType::DIV:
     {
-        auto* lhs = static_cast<AST*>(&(*op_node)[0]);
-        auto* rhs = static_cast<AST*>(&(*op_node)[1]);
+        ASTRef lhs = op_node[0];
+        ASTRef rhs = op_node[1];
 
         VariableType ret_type = writeObject(rhs, instructions);
         writeObject(lhs, instructions);
 
-        auto op_type = static_cast<uint32_t>(static_cast<OperationNode*>(op_node->value().get())->op_type);
+        auto op_type = static_cast<uint32_t>(static_cast<OperationNode*>(op_node.value())->op_type);
         op_type -= static_cast<uint32_t>(OperationType::ADD);
 
         uint32_t null = 0;
@@ -247,27 +668,51 @@ VariableType Translator::writeOperation(AST* op_node, std::stringstream* instruc
 
         instructions->write(reinterpret_cast<char*>(&op_code), 1);
         instructions->write(reinterpret_cast<char*>(&null), 3);
+        popStack(2);
+        pushStack();
+        return ret_type;
+    }
+    case OperationType::SHL:
+    {
+        writeObject(op_node[1], instructions);
+        VariableType ret_type = writeObject(op_node[0], instructions);
+
+        uint32_t null = 0;
+        auto op_code = static_cast<uint8_t>(Opcode::ISHL);
+        instructions->write(reinterpret_cast<char*>(&op_code), 1);
+        instructions->write(reinterpret_cast<char*>(&null), 3);
+        popStack(2);
+        pushStack();
         return ret_type;
     }
+    case OperationType::OR:
+    case OperationType::AND:
+    case OperationType::EQ:
+    case OperationType::NEQ:
+    case OperationType::LEQ:
+    case OperationType::GEQ:
+    case OperationType::STL:
+    case OperationType::STG:
+        return writeComparison(op_node, instructions);
     case OperationType::ASSIGN:
     {
-        auto* lhs = &(*op_node)[0];
-        auto* rhs = &(*op_node)[1];
+        ASTRef lhs = op_node[0];
+        ASTRef rhs = op_node[1];
 
-        VariableType ret_type = writeObject(static_cast<AST*>(rhs), instructions);
+        VariableType ret_type = writeObject(rhs, instructions);
 
-        switch (lhs->value()->type())
+        switch (lhs.value()->type())
         {
         case NodeType::VAR_DECL:
         {
-            auto* var_decl_node = static_cast<VariableDeclarationNode*>(lhs->value().get());
+            auto* var_decl_node = static_cast<VariableDeclarationNode*>(lhs.value());
             appendLocal(var_decl_node);
             writeStore(var_decl_node->name, instructions);
             return ret_type;
         }
         case NodeType::VARIABLE:
         {
-            auto* var_node = static_cast<VariableNode*>(lhs->value().get());
+            auto* var_node = static_cast<VariableNode*>(lhs.value());
             writeStore(var_node->name, instructions);
             return ret_type;
         }
@@ -278,7 +723,7 @@ VariableType Translator::writeOperation(AST* op_node, std::stringstream* instruc
     }
     case OperationType::RETURN:
     {
-        VariableType ret_type = writeObject(static_cast<AST*>(&(*op_node)[0]), instructions);
+        VariableType ret_type = writeObject(op_node[0], instructions);
 
         uint32_t null = 0;
         uint8_t op_code = 0;
@@ -302,6 +747,7 @@ VariableType Translator::writeOperation(AST* op_node, std::stringstream* instruc
 
         instructions->write(reinterpret_cast<char*>(&op_code), 1);
         instructions->write(reinterpret_cast<char*>(&null), 3);
+        popStack();
 
         return ret_type;
     }
@@ -312,18 +758,18 @@ VariableType Translator::writeOperation(AST* op_node, std::stringstream* instruc
     return VariableType::VOID;
 }
 
-VariableType Translator::writeFunction(AST* func_node, std::stringstream* instructions)
+VariableType Translator::writeFunction(ASTRef func_node, std::stringstream* instructions)
 {
-    for (size_t i = 0; i < func_node->branches_num(); i++)
+    for (size_t i = 0; i < func_node.branches_num(); i++)
     {
-        writeObject(static_cast<AST*>(&(*func_node)[i]), instructions);
+        writeObject(func_node[i], instructions);
     }
 
     uint8_t null = 0;
     auto op_code = static_cast<uint8_t>(Opcode::INVOKESTATIC);
 
     auto cp_size = static_cast<uint16_t>(const_pool_.size());
-    std::string func_name = static_cast<FunctionNode*>(func_node->value().get())->name;
+    std::string func_name = static_cast<FunctionNode*>(func_node.value())->name;
 
     if (!const_pool_.contains(std::make_unique<StringType>(StringType(func_name))))
     {
@@ -337,8 +783,14 @@ VariableType Translator::writeFunction(AST* func_node, std::stringstream* instru
     instructions->write(reinterpret_cast<char*>(&op_code), 1);
     instructions->write(reinterpret_cast<char*>(&null), 1);
     instructions->write(reinterpret_cast<char*>(&cp_size), sizeof(cp_size));
+    popStack(static_cast<uint16_t>(func_node.branches_num()));
 
-    return VariableType::INT;
+    VariableType ret_type = methods_.contains(func_name) ? methods_[func_name] : VariableType::INT;
+    if (ret_type != VariableType::VOID)
+    {
+        pushStack();
+    }
+    return ret_type;
 }
 
 VariableType Translator::writeNumber(NumberNode* num_node, std::stringstream* instructions)
@@ -380,12 +832,20 @@ VariableType Translator::writeNumber(NumberNode* num_node, std::stringstream* in
     instructions->write(reinterpret_cast<char*>(&op_code), 1);
     instructions->write(reinterpret_cast<char*>(&null), 1);
     instructions->write(reinterpret_cast<char*>(&cp_size), sizeof(cp_size));
+    pushStack();
 
     return ret_type;
 }
 
 void Translator::writeStore(const std::string& name, std::stringstream* instructions)
 {
+    if (!locals_.contains(name) && statics_.contains(name))
+    {
+        writeStatic(Opcode::PUTSTATIC, name, instructions);
+        popStack();
+        return;
+    }
+
     uint8_t null = 0;
     uint8_t op_code = 0;
     uint16_t index = locals_[name].first;
@@ -415,10 +875,22 @@ void Translator::writeStore(const std::string& name, std::stringstream* instruct
     instructions->write(reinterpret_cast<char*>(&op_code), 1);
     instructions->write(reinterpret_cast<char*>(&null), 1);
     instructions->write(reinterpret_cast<char*>(&index), sizeof(index));
+    popStack();
 }
 
 VariableType Translator::writeLoad(const std::string& name, std::stringstream* instructions)
 {
+    if (!locals_.contains(name) && statics_.contains(name))
+    {
+        writeStatic(Opcode::GETSTATIC, name, instructions);
+        pushStack();
+
+        VariableType var_type = statics_[name];
+        bool int_type = (var_type == VariableType::BOOLEAN) || (var_type == VariableType::BYTE) ||
+                        (var_type == VariableType::CHAR) || (var_type == VariableType::SHORT);
+        return int_type ? VariableType::INT : var_type;
+    }
+
     uint8_t null = 0;
     uint8_t op_code = 0;
     uint16_t index = locals_[name].first;
@@ -453,6 +925,94 @@ VariableType Translator::writeLoad(const std::string& name, std::stringstream* i
     instructions->write(reinterpret_cast<char*>(&op_code), 1);
     instructions->write(reinterpret_cast<char*>(&null), 1);
     instructions->write(reinterpret_cast<char*>(&index), sizeof(index));
+    pushStack();
 
     return ret_type;
+}
+
+void Translator::writeStatic(Opcode op, const std::string& name, std::stringstream* instructions)
+{
+    uint8_t null = 0;
+    auto op_code = static_cast<uint8_t>(op);
+    auto cp_size = static_cast<uint16_t>(const_pool_.size());
+
+    if (!const_pool_.contains(std::make_unique<StringType>(StringType(name))))
+    {
+        const_pool_[std::make_unique<StringType>(StringType(name))] = cp_size;
+    }
+    else
+    {
+        cp_size = const_pool_[std::make_unique<StringType>(StringType(name))];
+    }
+
+    instructions->write(reinterpret_cast<char*>(&op_code), 1);
+    instructions->write(reinterpret_cast<char*>(&null), 1);
+    instructions->write(reinterpret_cast<char*>(&cp_size), sizeof(cp_size));
+}
+
+void Translator::writeOpcode(Opcode op, std::stringstream* instructions)
+{
+    uint32_t null = 0;
+    auto op_code = static_cast<uint8_t>(op);
+    instructions->write(reinterpret_cast<char*>(&op_code), 1);
+    instructions->write(reinterpret_cast<char*>(&null), 3);
+}
+
+size_t Translator::newLabel()
+{
+    labels_.push_back({-1, {}, {}});
+    return labels_.size() - 1;
+}
+
+void Translator::bindLabel(size_t label, std::stringstream* instructions)
+{
+    labels_[label].offset = static_cast<int32_t>(instructions->tellp());
+}
+
+void Translator::writeBranch(Opcode op, size_t label, std::stringstream* instructions)
+{
+    labels_[label].branches.push_back(static_cast<uint32_t>(instructions->tellp()));
+    writeOpcode(op, instructions);
+}
+
+void Translator::writeSwitchTarget(size_t label, uint32_t switch_pos, std::stringstream* instructions)
+{
+    int32_t null = 0;
+    labels_[label].words.emplace_back(static_cast<uint32_t>(instructions->tellp()), switch_pos);
+    instructions->write(reinterpret_cast<char*>(&null), sizeof(null));
+}
+
+// Returns false if a branch does not reach its label with a 16-bit offset.
+bool Translator::resolveLabels(std::string* code) const
+{
+    for (const auto& label : labels_)
+    {
+        for (uint32_t branch : label.branches)
+        {
+            int32_t offset = label.offset - static_cast<int32_t>(branch);
+            if (offset < INT16_MIN || offset > INT16_MAX)
+            {
+                return false;
+            }
+            auto offset16 = static_cast<int16_t>(offset);
+            std::memcpy(&(*code)[branch + 2], &offset16, sizeof(offset16));
+        }
+        for (auto [word, switch_pos] : label.words)
+        {
+            int32_t offset = label.offset - static_cast<int32_t>(switch_pos);
+            std::memcpy(&(*code)[word], &offset, sizeof(offset));
+        }
+    }
+    return true;
+}
+
+void Translator::pushStack(uint16_t num)
+{
+    stack_size_ += num;
+    max_stack_ = std::max(max_stack_, stack_size_);
+}
+
+void Translator::popStack(uint16_t num)
+{
+    stack_size_ -= std::min(stack_size_, num);
 }
\ No newline at end of file
@@ -1,132 +1,349 @@
 #include "VM/ClassLinker.h"
+#include "VM/Metrics/Metrics.h"
+#include "VM/Trace/Tracer.h"
+#include "VM/Verifier.h"
+#include "Opcodes.h"
 
-void ClassLinker::link(const Klasses& klasses)
+#include <cstring>
+
+int ClassLinker::link(const Klasses& klasses)
 {
+    Tracer::Scope trace("link", "link");
     for (const auto& klass : klasses)
     {
-        appendClass(klass);
+        if (!appendClass(klass))
+        {
+            return KLASS_CORRUPTED;
+        }
+    }
+
+    Tracer::Scope verify_trace("link", "verify");
+    Verifier verifier(&classes);
+    if (!verifier.verify())
+    {
+        errors_ = std::move(*verifier.getErrors());
+        return CLASS_NOT_VERIFIED;
+    }
+
+    for (auto& [class_name, cls] : classes)
+    {
+        allocateStatics(&cls);
+    }
+
+    for (auto& [class_name, cls] : classes)
+    {
+        resolveConstants(class_name, &cls);
+        quickenStatics(class_name, &cls);
+    }
+
+    return OK;
+}
+
+void ClassLinker::printErrors(std::ostream& os) const
+{
+    for (const auto& err : errors_)
+    {
+        os << err << "\n";
+    }
+}
+
+void ClassLinker::allocateStatics(PkmClass* cls)
+{
+    for (auto& [field_name, field] : cls->fields)
+    {
+        if (field.modifier == FieldType::STATIC)
+        {
+            field.index = static_cast<uint16_t>(cls->statics.size());
+            cls->statics.push_back(PkmValue {.l = 0});
+        }
+    }
+}
+
+void ClassLinker::resolveConstants(const std::string& class_name, PkmClass* cls)
+{
+    for (auto& [method_name, method] : cls->methods)
+    {
+        method.cls = cls;
+    }
+
+    cls->constants.assign(cls->const_pool.size(), PkmValue {.l = 0});
+    cls->method_refs.assign(cls->const_pool.size(), nullptr);
+    for (size_t i = 0; i < cls->const_pool.size(); i++)
+    {
+        const AbstractType* cst = cls->const_pool[i].get();
+        switch (cst->type())
+        {
+        case AbstractType::Type::INTEGER:
+            cls->constants[i].i = static_cast<const IntegerType*>(cst)->value;
+            break;
+        case AbstractType::Type::FLOAT:
+            cls->constants[i].f = static_cast<const FloatType*>(cst)->value;
+            break;
+        case AbstractType::Type::STRING:
+            cls->method_refs[i] =
+                Verifier::resolveMethod(&classes, class_name, static_cast<const StringType*>(cst)->value);
+            break;
+        }
+    }
+}
+
+// Instructions have no room for a pointer, so the quick forms index
+// static_refs, which holds the absolute address of each accessed slot.
+void ClassLinker::quickenStatics(const std::string& class_name, PkmClass* cls)
+{
+    std::unordered_map<uint16_t, uint16_t> quick_index;
+    for (size_t pos = 0; pos + INSTRUCTION_SIZE <= cls->bytecode.size(); pos += instructionSize(&cls->bytecode[pos]))
+    {
+        auto op = static_cast<Opcode>(cls->bytecode[pos]);
+        if ((op != Opcode::GETSTATIC) && (op != Opcode::PUTSTATIC))
+        {
+            continue;
+        }
+
+        uint16_t index = 0;
+        std::memcpy(&index, &cls->bytecode[pos + 2], sizeof(index));
+        if (!quick_index.contains(index))
+        {
+            if ((index >= cls->const_pool.size()) || (cls->const_pool[index]->type() != AbstractType::Type::STRING))
+            {
+                continue;
+            }
+
+            PkmClass* owner = nullptr;
+            const auto* ref = static_cast<const StringType*>(cls->const_pool[index].get());
+            PkmField* field = Verifier::resolveField(&classes, class_name, ref->value, &owner);
+            if (!field || (field->modifier != FieldType::STATIC))
+            {
+                continue;
+            }
+
+            quick_index[index] = static_cast<uint16_t>(cls->static_refs.size());
+            cls->static_refs.push_back(&owner->statics[field->index]);
+        }
+
+        auto quick_op = (op == Opcode::GETSTATIC) ? Opcode::GETSTATIC_QUICK : Opcode::PUTSTATIC_QUICK;
+        cls->bytecode[pos] = static_cast<char>(quick_op);
+        std::memcpy(&cls->bytecode[pos + 2], &quick_index[index], sizeof(uint16_t));
     }
 }
 
-void ClassLinker::appendClass(const std::string& klass)
+bool ClassLinker::appendClass(const std::string& klass)
 {
+    Tracer::Scope trace("link", "appendClass");
     size_t pos = 0;
-    std::string class_name = getString(klass, &pos);
+    std::string class_name;
+    if (!getString(&class_name, klass, &pos))
+    {
+        errors_.push_back("klass corrupted: no class name");
+        return false;
+    }
 
-    getConstantPool(&classes[class_name].const_pool, klass, &pos);
+    if (classes.contains(class_name))
+    {
+        errors_.push_back("class " + class_name + " is already linked");
+        return false;
+    }
+    trace.detail(class_name);
 
-    getFields(&classes[class_name].fields, klass, &pos);
-    getMethods(&classes[class_name].methods, klass, &pos);
+    PkmClass* cls = &classes[class_name];
+    cls->name = class_name;
+    if (!getConstantPool(&cls->const_pool, klass, &pos) || !getFields(&cls->fields, klass, &pos) ||
+        !getMethods(&cls->methods, klass, &pos))
+    {
+        errors_.push_back("klass corrupted: " + class_name);
+        classes.erase(class_name);
+        return false;
+    }
 
-    classes[class_name].bytecode = klass.substr(pos);
+    cls->bytecode = klass.substr(pos);
+    Metrics::add(&Metrics::Segment::classes_linked);
+    Metrics::add(&Metrics::Segment::methods_linked, cls->methods.size());
+    return true;
 }
 
-std::string ClassLinker::getString(const std::string& klass, size_t* pos)
+bool ClassLinker::getString(std::string* str, const std::string& klass, size_t* pos)
 {
-    size_t start = *pos;
-    while ((*pos < klass.length()) && klass[*pos])
+    size_t end = klass.find('\0', *pos);
+    if (end == std::string::npos)
     {
-        (*pos)++;
+        return false;
     }
-    (*pos)++;
-    return klass.substr(start, *pos - 1 - start);
+    *str = klass.substr(*pos, end - *pos);
+    *pos = end + 1;
+    return true;
 }
 
-void ClassLinker::getConstantPool(ConstPool* const_pool, const std::string& klass, size_t* pos)
+template<typename T>
+bool ClassLinker::getValue(T* value, const std::string& klass, size_t* pos)
 {
-    auto cp_size = *reinterpret_cast<const uint16_t*>(&klass[*pos]);
-    (*pos) += sizeof(cp_size);
+    if (*pos + sizeof(T) > klass.length())
+    {
+        return false;
+    }
+    std::memcpy(value, &klass[*pos], sizeof(T));
+    (*pos) += sizeof(T);
+    return true;
+}
+
+bool ClassLinker::getName(std::string* name, uint16_t index) const
+{
+    if ((index >= const_pool_ptr_->size()) || ((*const_pool_ptr_)[index]->type() != AbstractType::Type::STRING))
+    {
+        return false;
+    }
+    *name = static_cast<StringType*>((*const_pool_ptr_)[index].get())->value;
+    return true;
+}
+
+bool ClassLinker::getConstantPool(ConstPool* const_pool, const std::string& klass, size_t* pos)
+{
+    uint16_t cp_size = 0;
+    if (!getValue(&cp_size, klass, pos))
+    {
+        return false;
+    }
     const_pool_ptr_ = const_pool;
 
     for (uint16_t i = 0; i < cp_size; i++)
     {
-        auto type = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
+        uint8_t type = 0;
+        if (!getValue(&type, klass, pos))
+        {
+            return false;
+        }
+
         switch (type)
         {
         case static_cast<uint8_t>(AbstractType::Type::INTEGER):
         {
-            auto value = *reinterpret_cast<const int32_t*>(&klass[*pos]);
-            (*pos) += sizeof(value);
+            int32_t value = 0;
+            if (!getValue(&value, klass, pos))
+            {
+                return false;
+            }
             const_pool->emplace_back(std::make_unique<IntegerType>(IntegerType(value)));
             break;
         }
         case static_cast<uint8_t>(AbstractType::Type::FLOAT):
         {
-            auto value = *reinterpret_cast<const float*>(&klass[*pos]);
-            (*pos) += sizeof(value);
+            float value = 0;
+            if (!getValue(&value, klass, pos))
+            {
+                return false;
+            }
             const_pool->emplace_back(std::make_unique<FloatType>(FloatType(value)));
             break;
         }
         case static_cast<uint8_t>(AbstractType::Type::STRING):
         {
-            auto value = getString(klass, pos);
+            std::string value;
+            if (!getString(&value, klass, pos))
+            {
+                return false;
+            }
             const_pool->emplace_back(std::make_unique<StringType>(StringType(value)));
             break;
         }
         default:
-            break;
+            return false;
         }
     }
+    return true;
 }
 
-void ClassLinker::getFields(PkmFields* fields, const std::string& klass, size_t* pos)
+bool ClassLinker::getFields(PkmFields* fields, const std::string& klass, size_t* pos)
 {
-    auto fields_num = static_cast<uint8_t>(klass[*pos]);
-    (*pos)++;
+    uint8_t fields_num = 0;
+    if (!getValue(&fields_num, klass, pos))
+    {
+        return false;
+    }
 
     for (uint8_t i = 0; i < fields_num; i++)
     {
-        auto access_type = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
-        auto var_type = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
-        auto name = *reinterpret_cast<const uint16_t*>(&klass[*pos]);
-        (*pos) += sizeof(name);
+        uint8_t access_type = 0;
+        uint8_t modifier = 0;
+        uint8_t var_type = 0;
+        uint16_t name = 0;
+        std::string field_name;
+        if (!getValue(&access_type, klass, pos) || !getValue(&modifier, klass, pos) ||
+            !getValue(&var_type, klass, pos) || !getValue(&name, klass, pos) || !getName(&field_name, name))
+        {
+            return false;
+        }
+
+        if ((access_type > static_cast<uint8_t>(AccessType::PRIVATE)) ||
+            (modifier > static_cast<uint8_t>(FieldType::STATIC)) ||
+            (var_type == static_cast<uint8_t>(VariableType::VOID)) ||
+            (var_type > static_cast<uint8_t>(VariableType::REFERENCE)))
+        {
+            return false;
+        }
 
-        auto field_name = static_cast<StringType*>((*const_pool_ptr_)[name].get())->value;
         (*fields)[field_name].access_type = static_cast<AccessType>(access_type);
+        (*fields)[field_name].modifier = static_cast<FieldType>(modifier);
         (*fields)[field_name].var_type = static_cast<VariableType>(var_type);
+        (*fields)[field_name].name = name;
     }
+    return true;
 }
 
-void ClassLinker::getMethods(PkmMethods* methods, const std::string& klass, size_t* pos)
+bool ClassLinker::getMethods(PkmMethods* methods, const std::string& klass, size_t* pos)
 {
-    auto methods_num = static_cast<uint8_t>(klass[*pos]);
-    (*pos)++;
+    uint8_t methods_num = 0;
+    if (!getValue(&methods_num, klass, pos))
+    {
+        return false;
+    }
 
     for (uint8_t i = 0; i < methods_num; i++)
     {
-        auto access_type = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
-        auto modifier = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
-        auto ret_type = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
-        auto name = *reinterpret_cast<const uint16_t*>(&klass[*pos]);
-        (*pos) += sizeof(name);
+        uint8_t access_type = 0;
+        uint8_t modifier = 0;
+        uint8_t ret_type = 0;
+        uint16_t name = 0;
+        std::string method_name;
+        if (!getValue(&access_type, klass, pos) || !getValue(&modifier, klass, pos) ||
+            !getValue(&ret_type, klass, pos) || !getValue(&name, klass, pos) || !getName(&method_name, name))
+        {
+            return false;
+        }
 
-        auto method_name = static_cast<StringType*>((*const_pool_ptr_)[name].get())->value;
-        (*methods)[method_name].access_type = static_cast<AccessType>(access_type);
-        (*methods)[method_name].modifier = static_cast<MethodType>(modifier);
-        (*methods)[method_name].ret_type = static_cast<VariableType>(ret_type);
+        if ((access_type > static_cast<uint8_t>(AccessType::PRIVATE)) ||
+            (modifier > static_cast<uint8_t>(MethodType::NATIVE)) ||
+            (ret_type > static_cast<uint8_t>(VariableType::REFERENCE)))
+        {
+            return false;
+        }
 
-        auto mps_num = static_cast<uint8_t>(klass[*pos]);
-        (*pos)++;
+        PkmMethod* method = &(*methods)[method_name];
+        method->access_type = static_cast<AccessType>(access_type);
+        method->modifier = static_cast<MethodType>(modifier);
+        method->ret_type = static_cast<VariableType>(ret_type);
+        method->name = name;
 
-        for (uint8_t m = 0; m < mps_num; m++)
+        uint8_t mps_num = 0;
+        if (!getValue(&mps_num, klass, pos))
         {
-            auto var_type = static_cast<uint8_t>(klass[*pos]);
-            (*pos)++;
-            (*methods)[method_name].met_params.push_back(static_cast<VariableType>(var_type));
+            return false;
         }
 
-        auto offset = *reinterpret_cast<const uint32_t*>(&klass[*pos]);
-        (*pos) += sizeof(offset);
-        (*methods)[method_name].offset = offset;
+        for (uint8_t m = 0; m < mps_num; m++)
+        {
+            uint8_t var_type = 0;
+            if (!getValue(&var_type, klass, pos) || (var_type == static_cast<uint8_t>(VariableType::VOID)) ||
+                (var_type > static_cast<uint8_t>(VariableType::REFERENCE)))
+            {
+                return false;
+            }
+            method->met_params.push_back(static_cast<VariableType>(var_type));
+        }
 
-        auto locals_num = *reinterpret_cast<const uint16_t*>(&klass[*pos]);
-        (*pos) += sizeof(locals_num);
-        (*methods)[method_name].locals_num = locals_num;
+        if (!getValue(&method->offset, klass, pos) || !getValue(&method->locals_num, klass, pos) ||
+            !getValue(&method->max_stack, klass, pos))
+        {
+            return false;
+        }
     }
+    return true;
 }
\ No newline at end of file
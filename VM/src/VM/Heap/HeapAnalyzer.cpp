@@ -0,0 +1,350 @@
+#include "VM/Heap/HeapAnalyzer.h"
+#include "VM/Heap/HeapSnapshot.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <utility>
+
+// Nodes are read on the first pass and edges on the second, so edge targets
+// are stored as node numbers right away instead of ids.
+int HeapAnalyzer::load(const std::string& file_name)
+{
+    *this = HeapAnalyzer();
+
+    HeapSnapshotReader reader;
+    HeapRecord record = {};
+    std::map<uint32_t, uint32_t> file_types;
+    int err = reader.open(file_name);
+    if (err)
+    {
+        return err;
+    }
+
+    edge_begin_.push_back(0);
+    for (err = reader.next(&record); !err && (record.tag != HeapRecord::END); err = reader.next(&record))
+    {
+        if (record.tag == HeapRecord::TYPE)
+        {
+            file_types[record.type] = static_cast<uint32_t>(type_names_.size());
+            type_names_.push_back(record.name);
+        }
+        else if (record.tag == HeapRecord::NODE)
+        {
+            if (!file_types.contains(record.type) || !index_.emplace(record.id, ids_.size()).second)
+            {
+                return WRONG_FORMAT;
+            }
+            ids_.push_back(record.id);
+            types_.push_back(file_types[record.type]);
+            sizes_.push_back(record.size);
+            edge_begin_.push_back(edge_begin_.back() + record.edges.size());
+        }
+    }
+    if (err)
+    {
+        return err;
+    }
+
+    // Edges to ids that are not in the snapshot are dropped.
+    reader = HeapSnapshotReader();
+    reader.open(file_name);
+    edges_.resize(edge_begin_.back());
+    size_t node = 0;
+    for (err = reader.next(&record); !err && (record.tag != HeapRecord::END); err = reader.next(&record))
+    {
+        if (record.tag == HeapRecord::NODE)
+        {
+            uint64_t pos = edge_begin_[node];
+            for (uint64_t target : record.edges)
+            {
+                auto it = index_.find(target);
+                edges_[pos++] = (it != index_.end()) ? it->second : NONE;
+            }
+            node++;
+        }
+        else if (record.tag == HeapRecord::ROOT)
+        {
+            auto it = index_.find(record.id);
+            if (it != index_.end())
+            {
+                roots_.push_back(it->second);
+            }
+        }
+    }
+    return err;
+}
+
+void HeapAnalyzer::analyze()
+{
+    buildPredecessors();
+    orderNodes();
+    computeDominators();
+    computeRetained();
+}
+
+size_t HeapAnalyzer::nodes() const
+{
+    return ids_.size();
+}
+
+uint32_t HeapAnalyzer::index(uint64_t id) const
+{
+    auto it = index_.find(id);
+    return (it != index_.end()) ? it->second : NONE;
+}
+
+uint64_t HeapAnalyzer::id(uint32_t node) const
+{
+    return ids_[node];
+}
+
+uint32_t HeapAnalyzer::dominator(uint32_t node) const
+{
+    return (idom_[node] == nodes()) ? NONE : idom_[node];
+}
+
+uint64_t HeapAnalyzer::retained(uint32_t node) const
+{
+    return retained_[node];
+}
+
+const std::vector<HeapAnalyzer::ClassStats>& HeapAnalyzer::classes() const
+{
+    return classes_;
+}
+
+// The virtual root, numbered nodes(), precedes every root.
+void HeapAnalyzer::buildPredecessors()
+{
+    auto root = static_cast<uint32_t>(nodes());
+    pred_begin_.assign(nodes() + 2, 0);
+    for (uint32_t target : edges_)
+    {
+        if (target != NONE)
+        {
+            pred_begin_[target + 2]++;
+        }
+    }
+    for (uint32_t node : roots_)
+    {
+        pred_begin_[node + 2]++;
+    }
+    for (size_t i = 2; i < pred_begin_.size(); i++)
+    {
+        pred_begin_[i] += pred_begin_[i - 1];
+    }
+
+    preds_.resize(pred_begin_.back());
+    for (uint32_t node = 0; node < nodes(); node++)
+    {
+        for (uint64_t pos = edge_begin_[node]; pos < edge_begin_[node + 1]; pos++)
+        {
+            if (edges_[pos] != NONE)
+            {
+                preds_[pred_begin_[edges_[pos] + 1]++] = node;
+            }
+        }
+    }
+    for (uint32_t node : roots_)
+    {
+        preds_[pred_begin_[node + 1]++] = root;
+    }
+}
+
+void HeapAnalyzer::orderNodes()
+{
+    auto root = static_cast<uint32_t>(nodes());
+    rank_.assign(nodes() + 1, NONE);
+    order_.clear();
+
+    // Explicit stack of (node, next successor) so deep graphs do not overflow.
+    std::vector<bool> visited(nodes() + 1, false);
+    std::vector<std::pair<uint32_t, uint64_t>> stack = {{root, 0}};
+    visited[root] = true;
+    while (!stack.empty())
+    {
+        auto& [node, next] = stack.back();
+        bool is_root = (node == root);
+        uint64_t end = is_root ? roots_.size() : edge_begin_[node + 1] - edge_begin_[node];
+        if (next == end)
+        {
+            order_.push_back(node);
+            stack.pop_back();
+            continue;
+        }
+
+        uint32_t succ = is_root ? roots_[next] : edges_[edge_begin_[node] + next];
+        next++;
+        if ((succ != NONE) && !visited[succ])
+        {
+            visited[succ] = true;
+            stack.emplace_back(succ, 0);
+        }
+    }
+
+    std::reverse(order_.begin(), order_.end());
+    for (size_t i = 0; i < order_.size(); i++)
+    {
+        rank_[order_[i]] = static_cast<uint32_t>(i);
+    }
+}
+
+// Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm".
+void HeapAnalyzer::computeDominators()
+{
+    auto root = static_cast<uint32_t>(nodes());
+    idom_.assign(nodes() + 1, NONE);
+    idom_[root] = root;
+
+    auto intersect = [this](uint32_t a, uint32_t b)
+    {
+        while (a != b)
+        {
+            while (rank_[a] > rank_[b])
+            {
+                a = idom_[a];
+            }
+            while (rank_[b] > rank_[a])
+            {
+                b = idom_[b];
+            }
+        }
+        return a;
+    };
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = 1; i < order_.size(); i++)
+        {
+            uint32_t node = order_[i];
+            uint32_t new_idom = NONE;
+            for (uint64_t pos = pred_begin_[node]; pos < pred_begin_[node + 1]; pos++)
+            {
+                uint32_t pred = preds_[pos];
+                if (idom_[pred] != NONE)
+                {
+                    new_idom = (new_idom == NONE) ? pred : intersect(pred, new_idom);
+                }
+            }
+            if (idom_[node] != new_idom)
+            {
+                idom_[node] = new_idom;
+                changed = true;
+            }
+        }
+    }
+}
+
+void HeapAnalyzer::computeRetained()
+{
+    auto root = static_cast<uint32_t>(nodes());
+    retained_.assign(nodes() + 1, 0);
+    for (uint32_t node : order_)
+    {
+        retained_[node] = (node == root) ? 0 : sizes_[node];
+    }
+    for (size_t i = order_.size() - 1; i > 0; i--)
+    {
+        retained_[idom_[order_[i]]] += retained_[order_[i]];
+    }
+
+    classes_.assign(type_names_.size(), ClassStats {});
+    for (size_t type = 0; type < type_names_.size(); type++)
+    {
+        classes_[type].name = type_names_[type];
+    }
+
+    // A class retains its topmost objects in the dominator tree; objects
+    // below another object of the same class are already inside its size.
+    // Indexed by dominator + 2, and the virtual root nodes() is a dominator too.
+    std::vector<uint64_t> child_begin(nodes() + 3, 0);
+    for (size_t i = 1; i < order_.size(); i++)
+    {
+        child_begin[idom_[order_[i]] + 2]++;
+    }
+    for (size_t i = 2; i < child_begin.size(); i++)
+    {
+        child_begin[i] += child_begin[i - 1];
+    }
+    std::vector<uint32_t> children(order_.empty() ? 0 : order_.size() - 1);
+    for (size_t i = 1; i < order_.size(); i++)
+    {
+        children[child_begin[idom_[order_[i]] + 1]++] = order_[i];
+    }
+
+    std::vector<size_t> open(type_names_.size(), 0);
+    std::vector<std::pair<uint32_t, uint64_t>> stack = {{root, child_begin[root]}};
+    while (!stack.empty())
+    {
+        auto& [node, next] = stack.back();
+        if (next == child_begin[node + 1])
+        {
+            if (node != root)
+            {
+                open[types_[node]]--;
+            }
+            stack.pop_back();
+            continue;
+        }
+
+        uint32_t child = children[next++];
+        ClassStats& stats = classes_[types_[child]];
+        stats.count++;
+        stats.shallow += sizes_[child];
+        if (open[types_[child]]++ == 0)
+        {
+            stats.retained += retained_[child];
+        }
+        stack.emplace_back(child, child_begin[child]);
+    }
+
+    std::stable_sort(classes_.begin(), classes_.end(), [](const ClassStats& a, const ClassStats& b) {
+        return a.retained > b.retained;
+    });
+}
+
+void HeapAnalyzer::print(std::ostream& os, size_t top) const
+{
+    size_t edges_num = 0;
+    for (uint32_t target : edges_)
+    {
+        edges_num += (target != NONE);
+    }
+    size_t reachable = order_.empty() ? 0 : order_.size() - 1;
+    os << "heap: " << nodes() << " nodes, " << edges_num << " edges, " << roots_.size() << " roots, "
+       << retained_[nodes()] << " bytes reachable, " << nodes() - reachable << " nodes unreachable\n";
+
+    os << "\nby class:\n"
+       << std::setw(10) << "count" << std::setw(14) << "shallow" << std::setw(14) << "retained" << "  class\n";
+    for (const auto& stats : classes_)
+    {
+        if (stats.count)
+        {
+            os << std::setw(10) << stats.count << std::setw(14) << stats.shallow << std::setw(14) << stats.retained
+               << "  " << stats.name << "\n";
+        }
+    }
+
+    std::vector<uint32_t> dominators;
+    for (size_t i = 1; i < order_.size(); i++)
+    {
+        if (idom_[order_[i]] == nodes())
+        {
+            dominators.push_back(order_[i]);
+        }
+    }
+    std::stable_sort(dominators.begin(), dominators.end(), [this](uint32_t a, uint32_t b) {
+        return retained_[a] > retained_[b];
+    });
+    dominators.resize(std::min(dominators.size(), top));
+
+    os << "\ntop dominators:\n" << std::setw(14) << "retained" << std::setw(14) << "shallow" << "  class (id)\n";
+    for (uint32_t node : dominators)
+    {
+        os << std::setw(14) << retained_[node] << std::setw(14) << sizes_[node] << "  " << type_names_[types_[node]]
+           << " (0x" << std::hex << ids_[node] << std::dec << ")\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "VM/Heap/HeapDumper.h"
+#include "VM/Heap/HeapSnapshot.h"
+
+static uint64_t nodeId(const void* ptr)
+{
+    return reinterpret_cast<uintptr_t>(ptr);
+}
+
+static uint64_t constantSize(const AbstractType* constant)
+{
+    switch (constant->type())
+    {
+    case AbstractType::Type::INTEGER:
+        return sizeof(IntegerType);
+    case AbstractType::Type::FLOAT:
+        return sizeof(FloatType);
+    default:
+        return sizeof(StringType) + static_cast<const StringType*>(constant)->value.capacity();
+    }
+}
+
+static const char* constantType(const AbstractType* constant)
+{
+    switch (constant->type())
+    {
+    case AbstractType::Type::INTEGER:
+        return "IntegerConstant";
+    case AbstractType::Type::FLOAT:
+        return "FloatConstant";
+    default:
+        return "StringConstant";
+    }
+}
+
+int HeapDumper::dump(const PkmClasses& classes, const std::string& file_name)
+{
+    HeapSnapshotWriter writer;
+    if (writer.open(file_name))
+    {
+        return HeapSnapshotWriter::FILE_NOT_OPENED;
+    }
+
+    uint32_t class_type = writer.type("Class");
+    uint32_t method_type = writer.type("Method");
+    uint32_t pool_type = writer.type("ConstantPool");
+    uint32_t bytecode_type = writer.type("Bytecode");
+    uint32_t statics_type = writer.type("Statics");
+
+    std::vector<uint64_t> edges;
+    for (const auto& [class_name, cls] : classes)
+    {
+        writer.root(nodeId(&cls));
+
+        edges = {nodeId(&cls.const_pool), nodeId(&cls.bytecode), nodeId(&cls.statics)};
+        for (const auto& [method_name, method] : cls.methods)
+        {
+            edges.push_back(nodeId(&method));
+        }
+        for (const PkmMethod* method : cls.method_refs)
+        {
+            edges.push_back(nodeId(method));
+        }
+        for (const PkmValue* value : cls.static_refs)
+        {
+            for (const auto& [other_name, other] : classes)
+            {
+                if ((&other != &cls) && (value >= other.statics.data()) &&
+                    (value < other.statics.data() + other.statics.size()))
+                {
+                    edges.push_back(nodeId(&other.statics));
+                }
+            }
+        }
+        uint64_t size = sizeof(PkmClass) + cls.name.capacity() + cls.constants.capacity() * sizeof(PkmValue) +
+                        cls.method_refs.capacity() * sizeof(PkmMethod*) +
+                        cls.static_refs.capacity() * sizeof(PkmValue*) + cls.fields.size() * sizeof(PkmField);
+        writer.node(nodeId(&cls), class_type, size, edges);
+
+        edges.clear();
+        for (const auto& constant : cls.const_pool)
+        {
+            edges.push_back(nodeId(constant.get()));
+            writer.node(nodeId(constant.get()), writer.type(constantType(constant.get())),
+                constantSize(constant.get()), {});
+        }
+        writer.node(nodeId(&cls.const_pool), pool_type, cls.const_pool.capacity() * sizeof(cls.const_pool[0]), edges);
+
+        writer.node(nodeId(&cls.bytecode), bytecode_type, cls.bytecode.capacity(), {});
+        writer.node(nodeId(&cls.statics), statics_type, cls.statics.capacity() * sizeof(PkmValue), {});
+
+        for (const auto& [method_name, method] : cls.methods)
+        {
+            edges = {nodeId(cls.const_pool[method.name].get())};
+            uint64_t method_size = sizeof(PkmMethod) + method.met_params.capacity() * sizeof(VariableType);
+            writer.node(nodeId(&method), method_type, method_size, edges);
+        }
+    }
+
+    return writer.close();
+}
\ No newline at end of file
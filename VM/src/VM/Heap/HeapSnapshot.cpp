@@ -0,0 +1,130 @@
+#include "VM/Heap/HeapSnapshot.h"
+
+#include <cstring>
+
+static const char HEAP_MAGIC[8] = {'P', 'K', 'M', 'H', 'E', 'A', 'P', '\0'};
+
+int HeapSnapshotWriter::open(const std::string& file_name)
+{
+    file_.open(file_name, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open())
+    {
+        return FILE_NOT_OPENED;
+    }
+
+    types_.clear();
+    file_.write(HEAP_MAGIC, sizeof(HEAP_MAGIC));
+    put(VERSION);
+    return OK;
+}
+
+int HeapSnapshotWriter::close()
+{
+    put(HeapRecord::END);
+    file_.close();
+    return file_.fail() ? WRITE_FAILED : OK;
+}
+
+template<typename T>
+void HeapSnapshotWriter::put(T value)
+{
+    file_.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+uint32_t HeapSnapshotWriter::type(const std::string& name)
+{
+    auto [it, inserted] = types_.emplace(name, static_cast<uint32_t>(types_.size()));
+    if (inserted)
+    {
+        put(HeapRecord::TYPE);
+        put(it->second);
+        put(static_cast<uint16_t>(name.size()));
+        file_.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    return it->second;
+}
+
+void HeapSnapshotWriter::node(uint64_t id, uint32_t type, uint64_t size, const std::vector<uint64_t>& edges)
+{
+    put(HeapRecord::NODE);
+    put(id);
+    put(type);
+    put(size);
+    put(static_cast<uint32_t>(edges.size()));
+    auto bytes = static_cast<std::streamsize>(edges.size() * sizeof(uint64_t));
+    file_.write(reinterpret_cast<const char*>(edges.data()), bytes);
+}
+
+void HeapSnapshotWriter::root(uint64_t id)
+{
+    put(HeapRecord::ROOT);
+    put(id);
+}
+
+int HeapSnapshotReader::open(const std::string& file_name)
+{
+    file_.open(file_name, std::ios::binary);
+    if (!file_.is_open())
+    {
+        return FILE_NOT_OPENED;
+    }
+
+    char magic[sizeof(HEAP_MAGIC)] = {};
+    uint32_t version = 0;
+    file_.read(magic, sizeof(magic));
+    if (!get(&version) || std::memcmp(magic, HEAP_MAGIC, sizeof(magic)) ||
+        (version != HeapSnapshotWriter::VERSION))
+    {
+        return WRONG_FORMAT;
+    }
+    return OK;
+}
+
+template<typename T>
+bool HeapSnapshotReader::get(T* value)
+{
+    return static_cast<bool>(file_.read(reinterpret_cast<char*>(value), sizeof(T)));
+}
+
+int HeapSnapshotReader::next(HeapRecord* record)
+{
+    if (!get(&record->tag))
+    {
+        return WRONG_FORMAT;
+    }
+
+    switch (record->tag)
+    {
+    case HeapRecord::END:
+        return OK;
+
+    case HeapRecord::TYPE:
+    {
+        uint16_t length = 0;
+        if (!get(&record->type) || !get(&length))
+        {
+            return WRONG_FORMAT;
+        }
+        record->name.resize(length);
+        return file_.read(record->name.data(), length) ? OK : WRONG_FORMAT;
+    }
+
+    case HeapRecord::NODE:
+    {
+        uint32_t edges_num = 0;
+        if (!get(&record->id) || !get(&record->type) || !get(&record->size) || !get(&edges_num))
+        {
+            return WRONG_FORMAT;
+        }
+        record->edges.resize(edges_num);
+        auto bytes = static_cast<std::streamsize>(edges_num * sizeof(uint64_t));
+        return file_.read(reinterpret_cast<char*>(record->edges.data()), bytes) ? OK : WRONG_FORMAT;
+    }
+
+    case HeapRecord::ROOT:
+        return get(&record->id) ? OK : WRONG_FORMAT;
+
+    default:
+        return WRONG_FORMAT;
+    }
+}
\ No newline at end of file
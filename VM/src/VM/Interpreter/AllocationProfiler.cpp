@@ -0,0 +1,147 @@
+#include "VM/Interpreter/AllocationProfiler.h"
+#include "VM/Pkm/PkmClass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+std::atomic<AllocationProfiler*> AllocationProfiler::running_ = nullptr;
+std::atomic<uint32_t> AllocationProfiler::generation_counter_ = 0;
+
+// Bytes the thread may still allocate before its next sample, drawn anew
+// whenever a different profiler run is seen.
+struct SampleClock
+{
+    std::mt19937_64 random {std::random_device {}()};
+    uint32_t generation = 0;
+    double remaining = 0;
+};
+
+static thread_local SampleClock sample_clock;
+
+AllocationProfiler::AllocationProfiler(size_t interval) : interval_(std::max<size_t>(interval, 1)) {}
+
+AllocationProfiler::~AllocationProfiler()
+{
+    stop();
+}
+
+int AllocationProfiler::start()
+{
+    AllocationProfiler* expected = nullptr;
+    if (!running_.compare_exchange_strong(expected, this))
+    {
+        return ALREADY_RUNNING;
+    }
+
+    generation_ = ++generation_counter_;
+    return OK;
+}
+
+void AllocationProfiler::stop()
+{
+    AllocationProfiler* expected = this;
+    running_.compare_exchange_strong(expected, nullptr);
+}
+
+void AllocationProfiler::allocate(const PkmMethod* method, const uint8_t* pc, const char* type, size_t bytes)
+{
+    AllocationProfiler* profiler = running_.load(std::memory_order_acquire);
+    if (!profiler)
+    {
+        return;
+    }
+
+    std::exponential_distribution<double> distance(1.0 / static_cast<double>(profiler->interval_));
+    if (sample_clock.generation != profiler->generation_)
+    {
+        sample_clock.generation = profiler->generation_;
+        sample_clock.remaining = distance(sample_clock.random);
+    }
+
+    sample_clock.remaining -= static_cast<double>(bytes);
+    if (sample_clock.remaining > 0)
+    {
+        return;
+    }
+
+    // One allocation is sampled at most once, however far it overshoots.
+    while (sample_clock.remaining <= 0)
+    {
+        sample_clock.remaining += distance(sample_clock.random);
+    }
+    const auto* code = reinterpret_cast<const uint8_t*>(method->cls->bytecode.data()) + method->offset;
+    profiler->sample({method, static_cast<uint32_t>(pc - code), type}, bytes);
+}
+
+void AllocationProfiler::sample(const Site& site, size_t bytes)
+{
+    // An allocation of size s is sampled with probability 1 - exp(-s / interval).
+    double size = static_cast<double>(std::max<size_t>(bytes, 1));
+    double scale = 1.0 / (1.0 - std::exp(-size / static_cast<double>(interval_)));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats& stats = sites_[site];
+    stats.samples++;
+    stats.bytes += static_cast<double>(bytes) * scale;
+    stats.count += scale;
+}
+
+std::map<AllocationProfiler::Site, AllocationProfiler::Stats> AllocationProfiler::sites() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sites_;
+}
+
+static std::string siteName(const AllocationProfiler::Site& site)
+{
+    const auto* name = static_cast<const StringType*>(site.method->cls->const_pool[site.method->name].get());
+    return site.method->cls->name + "." + name->value + ":" + std::to_string(site.offset);
+}
+
+void AllocationProfiler::writeSummary(std::ostream& os) const
+{
+    using Row = std::pair<Site, Stats>;
+    std::map<Site, Stats> all = sites();
+    std::vector<Row> rows(all.begin(), all.end());
+
+    double total_bytes = 0;
+    double total_count = 0;
+    size_t total_samples = 0;
+    for (const auto& [site, stats] : rows)
+    {
+        total_bytes += stats.bytes;
+        total_count += stats.count;
+        total_samples += stats.samples;
+    }
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(0) << "allocation profile: " << total_bytes << " bytes in " << total_count
+       << " allocations, " << total_samples << " samples, 1 per " << interval_ << " bytes\n";
+
+    auto print = [&](const char* title, auto greater)
+    {
+        std::stable_sort(rows.begin(), rows.end(), greater);
+        os << "\n" << title << "\n"
+           << std::setw(14) << "bytes" << std::setw(8) << "%" << std::setw(12) << "count" << "  site (type)\n";
+        for (const auto& [site, stats] : rows)
+        {
+            double share = (total_bytes > 0) ? 100 * stats.bytes / total_bytes : 0;
+            os << std::setprecision(0) << std::setw(14) << stats.bytes << std::setprecision(1) << std::setw(7) << share
+               << "%" << std::setprecision(0) << std::setw(12) << stats.count << "  " << siteName(site) << " ("
+               << site.type << ")\n";
+        }
+    };
+    print("by bytes:", [](const Row& a, const Row& b) {
+        return std::tie(a.second.bytes, a.second.count) > std::tie(b.second.bytes, b.second.count);
+    });
+    print("by count:", [](const Row& a, const Row& b) {
+        return std::tie(a.second.count, a.second.bytes) > std::tie(b.second.count, b.second.bytes);
+    });
+    os.flags(flags);
+    os.precision(precision);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "VM/Interpreter/ExecStack.h"
+#include "VM/Metrics/Metrics.h"
+
+#include <memory>
+#include <sys/mman.h>
+#include <unistd.h>
+
+ExecStack::ExecStack(size_t size)
+{
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size = (size + page_size - 1) / page_size * page_size;
+    region_size_ = size + page_size;
+
+    region_ = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region_ == MAP_FAILED)
+    {
+        region_ = nullptr;
+        region_size_ = 0;
+        return;
+    }
+
+    Metrics::add(&Metrics::Segment::stack_reserved_bytes, region_size_);
+    base_ = static_cast<PkmValue*>(region_);
+    limit_ = base_ + size / sizeof(PkmValue);
+    mprotect(limit_, page_size, PROT_NONE);
+}
+
+ExecStack::~ExecStack()
+{
+    if (region_)
+    {
+        munmap(region_, region_size_);
+    }
+}
+
+ExecStack* ExecStack::current()
+{
+    thread_local std::unique_ptr<ExecStack> stack(new ExecStack);
+    return stack.get();
+}
+
+PkmValue* ExecStack::base() const
+{
+    return base_;
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+#include "VM/Interpreter/Interpreter.h"
+#include "Opcodes.h"
+#include "VM/Interpreter/AllocationProfiler.h"
+#include "VM/Interpreter/OpcodeStats.h"
+#include "VM/Interpreter/Profiler.h"
+#include "VM/Metrics/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+template<typename T>
+static inline T wrap(std::make_unsigned_t<T> value)
+{
+    return static_cast<T>(value);
+}
+
+template<typename T>
+static inline std::make_unsigned_t<T> bits(T value)
+{
+    return static_cast<std::make_unsigned_t<T>>(value);
+}
+
+template<typename T>
+static inline int compare(T lhs, T rhs, int unordered)
+{
+    if (lhs > rhs)
+    {
+        return 1;
+    }
+    if (lhs < rhs)
+    {
+        return -1;
+    }
+    return (lhs == rhs) ? 0 : unordered;
+}
+
+// NaN converts to zero and out of range values saturate.
+template<typename To, typename From>
+static inline To toIntegral(From value)
+{
+    if (std::isnan(value))
+    {
+        return 0;
+    }
+    if (value >= static_cast<From>(std::numeric_limits<To>::max()))
+    {
+        return std::numeric_limits<To>::max();
+    }
+    if (value <= static_cast<From>(std::numeric_limits<To>::min()))
+    {
+        return std::numeric_limits<To>::min();
+    }
+    return static_cast<To>(value);
+}
+
+static inline const uint8_t* code(const PkmMethod* method)
+{
+    return reinterpret_cast<const uint8_t*>(method->cls->bytecode.data()) + method->offset;
+}
+
+// Stack bytes a call takes beyond the arguments the caller already pushed.
+static size_t frameSize(const PkmMethod* method)
+{
+    return (method->locals_num - method->met_params.size() + method->max_stack) * sizeof(PkmValue) + sizeof(Frame);
+}
+
+// Reads the ind-th operand word following a switch instruction.
+static inline int32_t word(const uint8_t* pc, uint32_t ind)
+{
+    int32_t value = 0;
+    std::memcpy(&value, pc + INSTRUCTION_SIZE * (ind + 1), sizeof(value));
+    return value;
+}
+
+static inline int32_t tableSwitch(const uint8_t* pc, uint16_t num, int32_t key)
+{
+    uint32_t ind = bits(key) - bits(word(pc, 1));
+    return (ind < num) ? word(pc, 2 + ind) : word(pc, 0);
+}
+
+static inline int32_t lookupSwitch(const uint8_t* pc, uint16_t num, int32_t key)
+{
+    uint32_t low = 0;
+    uint32_t high = num;
+    while (low < high)
+    {
+        uint32_t mid = (low + high) / 2;
+        int32_t mid_key = word(pc, 1 + 2 * mid);
+        if (mid_key == key)
+        {
+            return word(pc, 2 + 2 * mid);
+        }
+        if (mid_key < key)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return word(pc, 0);
+}
+
+#define BINARY(member, expr)                                \
+    {                                                       \
+        auto lhs = sp[-1].member;                           \
+        auto rhs = sp[-2].member;                           \
+        sp--;                                               \
+        sp[-1].member = (expr);                             \
+        break;                                              \
+    } //
+
+#define DIVISION(member, minus_one, expr)                   \
+    {                                                       \
+        auto lhs = sp[-1].member;                           \
+        auto rhs = sp[-2].member;                           \
+        if (rhs == 0)                                       \
+        {                                                   \
+            return ARITHMETIC_ERROR;                        \
+        }                                                   \
+        sp--;                                               \
+        sp[-1].member = (rhs == -1) ? (minus_one) : (expr); \
+        break;                                              \
+    } //
+
+#define SHIFT(member, type, expr)                           \
+    {                                                       \
+        type lhs = sp[-1].member;                           \
+        int32_t rhs = sp[-2].i;                             \
+        sp--;                                               \
+        sp[-1].member = (expr);                             \
+        break;                                              \
+    } //
+
+#define CONVERT(from, to, expr)                             \
+    {                                                       \
+        auto value = sp[-1].from;                           \
+        sp[-1].to = (expr);                                 \
+        break;                                              \
+    } //
+
+#define COMPARE(member, unordered)                          \
+    {                                                       \
+        auto lhs = sp[-1].member;                           \
+        auto rhs = sp[-2].member;                           \
+        sp--;                                               \
+        sp[-1].i = compare(lhs, rhs, unordered);            \
+        break;                                              \
+    } //
+
+int Interpreter::execute(PkmMethod* method, const std::vector<PkmValue>& args, PkmValue* result)
+{
+#ifdef VM_OPCODE_STATS
+    OpcodeStats::Scope stats_scope;
+#endif
+    if (!Profiler::active())
+    {
+        return run<false>(method, args, result);
+    }
+
+    int err = run<true>(method, args, result);
+    Profiler::publish(nullptr);
+    return err;
+}
+
+// The sampled loop keeps the pc of the top frame current and publishes the
+// frame for the profiler; the plain loop pays nothing for it.
+template<bool SAMPLED>
+int Interpreter::run(PkmMethod* method, const std::vector<PkmValue>& args, PkmValue* result)
+{
+    ExecStack* stack = ExecStack::current();
+    if (!stack->base())
+    {
+        return STACK_OVERFLOW;
+    }
+
+    PkmValue* locals = stack->base();
+    std::copy(args.begin(), args.end(), locals);
+
+    Frame* frame = stack->pushFrame(nullptr, method, locals);
+    if (!frame)
+    {
+        return STACK_OVERFLOW;
+    }
+
+    PkmValue* sp = reinterpret_cast<PkmValue*>(frame + 1);
+    const PkmClass* cls = method->cls;
+    const uint8_t* pc = code(method);
+#ifdef VM_OPCODE_STATS
+    OpcodeStats* stats = OpcodeStats::local();
+#endif
+    Metrics::Tally executed(&Metrics::Segment::instructions_executed);
+
+    while (true)
+    {
+        ++executed;
+#ifdef VM_OPCODE_STATS
+        stats->record(*pc);
+#endif
+        if constexpr (SAMPLED)
+        {
+            frame->pc = pc;
+            Profiler::publish(frame);
+        }
+
+        uint16_t arg = 0;
+        std::memcpy(&arg, pc + 2, sizeof(arg));
+
+        auto op = static_cast<Opcode>(*pc);
+        switch (op)
+        {
+        case Opcode::NOP:
+            break;
+
+        case Opcode::LDC:
+            *sp++ = cls->constants[arg];
+            break;
+
+        case Opcode::ILOAD:
+        case Opcode::LLOAD:
+        case Opcode::FLOAD:
+        case Opcode::DLOAD:
+        case Opcode::ALOAD:
+            *sp++ = locals[arg];
+            break;
+
+        case Opcode::ISTORE:
+        case Opcode::LSTORE:
+        case Opcode::FSTORE:
+        case Opcode::DSTORE:
+        case Opcode::ASTORE:
+            locals[arg] = *--sp;
+            break;
+
+        case Opcode::POP:
+            sp--;
+            break;
+        case Opcode::POP2:
+            sp -= 2;
+            break;
+        case Opcode::DUP:
+            sp[0] = sp[-1];
+            sp++;
+            break;
+        case Opcode::DUP2:
+            sp[0] = sp[-2];
+            sp[1] = sp[-1];
+            sp += 2;
+            break;
+
+        case Opcode::IADD: BINARY(i, wrap<int32_t>(bits(lhs) + bits(rhs)))
+        case Opcode::ISUB: BINARY(i, wrap<int32_t>(bits(lhs) - bits(rhs)))
+        case Opcode::IMUL: BINARY(i, wrap<int32_t>(bits(lhs) * bits(rhs)))
+        case Opcode::IDIV: DIVISION(i, wrap<int32_t>(0U - bits(lhs)), lhs / rhs)
+        case Opcode::IREM: DIVISION(i, 0, lhs % rhs)
+        case Opcode::LADD: BINARY(l, wrap<int64_t>(bits(lhs) + bits(rhs)))
+        case Opcode::LSUB: BINARY(l, wrap<int64_t>(bits(lhs) - bits(rhs)))
+        case Opcode::LMUL: BINARY(l, wrap<int64_t>(bits(lhs) * bits(rhs)))
+        case Opcode::LDIV: DIVISION(l, wrap<int64_t>(0U - bits(lhs)), lhs / rhs)
+        case Opcode::LREM: DIVISION(l, 0, lhs % rhs)
+        case Opcode::FADD: BINARY(f, lhs + rhs)
+        case Opcode::FSUB: BINARY(f, lhs - rhs)
+        case Opcode::FMUL: BINARY(f, lhs * rhs)
+        case Opcode::FDIV: BINARY(f, lhs / rhs)
+        case Opcode::FREM: BINARY(f, std::fmod(lhs, rhs))
+        case Opcode::DADD: BINARY(d, lhs + rhs)
+        case Opcode::DSUB: BINARY(d, lhs - rhs)
+        case Opcode::DMUL: BINARY(d, lhs * rhs)
+        case Opcode::DDIV: BINARY(d, lhs / rhs)
+        case Opcode::DREM: BINARY(d, std::fmod(lhs, rhs))
+
+        case Opcode::ISHL: SHIFT(i, int32_t, wrap<int32_t>(bits(lhs) << (rhs & 0x1F)))
+        case Opcode::ISHR: SHIFT(i, int32_t, lhs >> (rhs & 0x1F))
+        case Opcode::LSHL: SHIFT(l, int64_t, wrap<int64_t>(bits(lhs) << (rhs & 0x3F)))
+        case Opcode::LSHR: SHIFT(l, int64_t, lhs >> (rhs & 0x3F))
+        case Opcode::IAND: BINARY(i, lhs & rhs)
+        case Opcode::LAND: BINARY(l, lhs & rhs)
+        case Opcode::IOR: BINARY(i, lhs | rhs)
+        case Opcode::LOR: BINARY(l, lhs | rhs)
+        case Opcode::IXOR: BINARY(i, lhs ^ rhs)
+        case Opcode::LXOR: BINARY(l, lhs ^ rhs)
+
+        case Opcode::INEG: CONVERT(i, i, wrap<int32_t>(0U - bits(value)))
+        case Opcode::LNEG: CONVERT(l, l, wrap<int64_t>(0U - bits(value)))
+        case Opcode::FNEG: CONVERT(f, f, -value)
+        case Opcode::DNEG: CONVERT(d, d, -value)
+        case Opcode::IINC:
+        {
+            auto inc = static_cast<int32_t>(static_cast<int8_t>(pc[1]));
+            locals[arg].i = wrap<int32_t>(bits(locals[arg].i) + bits(inc));
+            break;
+        }
+
+        case Opcode::I2L: CONVERT(i, l, value)
+        case Opcode::I2F: CONVERT(i, f, static_cast<float>(value))
+        case Opcode::I2D: CONVERT(i, d, value)
+        case Opcode::L2I: CONVERT(l, i, static_cast<int32_t>(value))
+        case Opcode::L2F: CONVERT(l, f, static_cast<float>(value))
+        case Opcode::L2D: CONVERT(l, d, static_cast<double>(value))
+        case Opcode::F2I: CONVERT(f, i, (toIntegral<int32_t>(value)))
+        case Opcode::F2L: CONVERT(f, l, (toIntegral<int64_t>(value)))
+        case Opcode::F2D: CONVERT(f, d, value)
+        case Opcode::D2I: CONVERT(d, i, (toIntegral<int32_t>(value)))
+        case Opcode::D2L: CONVERT(d, l, (toIntegral<int64_t>(value)))
+        case Opcode::D2F: CONVERT(d, f, static_cast<float>(value))
+        case Opcode::I2B: CONVERT(i, i, static_cast<int8_t>(value))
+        case Opcode::I2C: CONVERT(i, i, static_cast<uint16_t>(value))
+        case Opcode::I2S: CONVERT(i, i, static_cast<int16_t>(value))
+
+        case Opcode::ICMP: COMPARE(i, 0)
+        case Opcode::LCMP: COMPARE(l, 0)
+        case Opcode::FCMPL: COMPARE(f, -1)
+        case Opcode::FCMPG: COMPARE(f, 1)
+        case Opcode::DCMPL: COMPARE(d, -1)
+        case Opcode::DCMPG: COMPARE(d, 1)
+
+        case Opcode::IFEQ:
+        case Opcode::IFNE:
+        case Opcode::IFLT:
+        case Opcode::IFGE:
+        case Opcode::IFGT:
+        case Opcode::IFLE:
+        {
+            int32_t value = (--sp)->i;
+            bool jump = false;
+            switch (op)
+            {
+            case Opcode::IFEQ: jump = (value == 0); break;
+            case Opcode::IFNE: jump = (value != 0); break;
+            case Opcode::IFLT: jump = (value < 0); break;
+            case Opcode::IFGE: jump = (value >= 0); break;
+            case Opcode::IFGT: jump = (value > 0); break;
+            default: jump = (value <= 0); break;
+            }
+            if (jump)
+            {
+                pc += static_cast<int16_t>(arg);
+                continue;
+            }
+            break;
+        }
+        case Opcode::IF_ICMPEQ:
+        case Opcode::IF_ICMPNE:
+        case Opcode::IF_ICMPLT:
+        case Opcode::IF_ICMPGE:
+        case Opcode::IF_ICMPGT:
+        case Opcode::IF_ICMPLE:
+        {
+            int32_t lhs = sp[-1].i;
+            int32_t rhs = sp[-2].i;
+            sp -= 2;
+            bool jump = false;
+            switch (op)
+            {
+            case Opcode::IF_ICMPEQ: jump = (lhs == rhs); break;
+            case Opcode::IF_ICMPNE: jump = (lhs != rhs); break;
+            case Opcode::IF_ICMPLT: jump = (lhs < rhs); break;
+            case Opcode::IF_ICMPGE: jump = (lhs >= rhs); break;
+            case Opcode::IF_ICMPGT: jump = (lhs > rhs); break;
+            default: jump = (lhs <= rhs); break;
+            }
+            if (jump)
+            {
+                pc += static_cast<int16_t>(arg);
+                continue;
+            }
+            break;
+        }
+        case Opcode::GOTO:
+            pc += static_cast<int16_t>(arg);
+            continue;
+        case Opcode::TABLESWITCH:
+            pc += tableSwitch(pc, arg, (--sp)->i);
+            continue;
+        case Opcode::LOOKUPSWITCH:
+            pc += lookupSwitch(pc, arg, (--sp)->i);
+            continue;
+
+        case Opcode::GETSTATIC_QUICK:
+            *sp++ = *cls->static_refs[arg];
+            break;
+        case Opcode::PUTSTATIC_QUICK:
+            *cls->static_refs[arg] = *--sp;
+            break;
+
+        case Opcode::INVOKESTATIC:
+        {
+            PkmMethod* callee = cls->method_refs[arg];
+            PkmValue* callee_locals = sp - callee->met_params.size();
+            Frame* callee_frame = stack->pushFrame(frame, callee, callee_locals);
+            if (!callee_frame)
+            {
+                return STACK_OVERFLOW;
+            }
+            if (AllocationProfiler::active())
+            {
+                AllocationProfiler::allocate(frame->method, pc, "Frame", frameSize(callee));
+            }
+
+            frame->pc = pc + 4;
+            frame = callee_frame;
+            locals = callee_locals;
+            sp = reinterpret_cast<PkmValue*>(frame + 1);
+            cls = callee->cls;
+            pc = code(callee);
+            continue;
+        }
+
+        case Opcode::IRETURN:
+        case Opcode::LRETURN:
+        case Opcode::FRETURN:
+        case Opcode::DRETURN:
+        case Opcode::ARETURN:
+        case Opcode::RETURN:
+        {
+            PkmValue ret = (op == Opcode::RETURN) ? PkmValue {.l = 0} : sp[-1];
+            Frame* caller = frame->prev;
+            sp = frame->locals;
+
+            if (!caller)
+            {
+                if (result)
+                {
+                    *result = ret;
+                }
+                return OK;
+            }
+
+            if (op != Opcode::RETURN)
+            {
+                *sp++ = ret;
+            }
+            frame = caller;
+            locals = frame->locals;
+            cls = frame->method->cls;
+            pc = frame->pc;
+            continue;
+        }
+
+        default:
+            return UNSUPPORTED_OPCODE;
+        }
+
+        pc += 4;
+    }
+}
+
+#undef BINARY
+#undef DIVISION
+#undef SHIFT
+#undef CONVERT
+#undef COMPARE
\ No newline at end of file
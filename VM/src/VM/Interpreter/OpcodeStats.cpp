@@ -0,0 +1,175 @@
+#ifdef VM_OPCODE_STATS
+
+#include "VM/Interpreter/OpcodeStats.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+static const char* const OPCODE_NAMES[] = {
+    "NOP", "LDC", "ILOAD", "LLOAD", "FLOAD", "DLOAD", "ALOAD", "IALOAD", "LALOAD", "FALOAD", "DALOAD", "AALOAD",
+    "BALOAD", "CALOAD", "SALOAD", "ISTORE", "LSTORE", "FSTORE", "DSTORE", "ASTORE", "IASTORE", "LASTORE", "FASTORE",
+    "DASTORE", "AASTORE", "BASTORE", "CASTORE", "SASTORE", "POP", "POP2", "DUP", "DUP2", "IADD", "ISUB", "IMUL",
+    "IDIV", "LADD", "LSUB", "LMUL", "LDIV", "FADD", "FSUB", "FMUL", "FDIV", "DADD", "DSUB", "DMUL", "DDIV", "IREM",
+    "LREM", "FREM", "DREM", "INEG", "LNEG", "FNEG", "DNEG", "ISHL", "LSHL", "ISHR", "LSHR", "IAND", "LAND", "IOR",
+    "LOR", "IXOR", "LXOR", "IINC", "I2L", "I2F", "I2D", "L2I", "L2F", "L2D", "F2I", "F2L", "F2D", "D2I", "D2L",
+    "D2F", "I2B", "I2C", "I2S", "ICMP", "LCMP", "FCMPL", "FCMPG", "DCMPL", "DCMPG", "IFEQ", "IFNE", "IFLT", "IFGE",
+    "IFGT", "IFLE", "GOTO", "TABLESWITCH", "LOOKUPSWITCH", "IRETURN", "LRETURN", "FRETURN", "DRETURN", "ARETURN",
+    "RETURN", "GETSTATIC", "PUTSTATIC", "GETFIELD", "PUTFIELD", "INVOKEINSTANCE", "INVOKESTATIC", "INVOKENATIVE",
+    "NEW", "NEWARRAY", "MULTINEWARRAY", "ANEWARRAY", "AMULTINEWARRAY", "ARRAYLENGTH", "GETSTATIC_QUICK",
+    "PUTSTATIC_QUICK", "IF_ICMPEQ", "IF_ICMPNE", "IF_ICMPLT", "IF_ICMPGE", "IF_ICMPGT", "IF_ICMPLE",
+};
+
+static const char* opcodeName(size_t op)
+{
+    return (op < std::size(OPCODE_NAMES)) ? OPCODE_NAMES[op] : "?";
+}
+
+static std::mutex total_mutex;
+
+OpcodeStats::OpcodeStats(bool merge_on_exit) :
+    counts_(OPCODES), cycles_(OPCODES), pairs_(OPCODES * OPCODES), merge_on_exit_(merge_on_exit)
+{}
+
+OpcodeStats::~OpcodeStats()
+{
+    if (merge_on_exit_)
+    {
+        std::lock_guard<std::mutex> lock(total_mutex);
+        total()->merge(*this);
+    }
+}
+
+OpcodeStats* OpcodeStats::local()
+{
+    total();
+    thread_local OpcodeStats stats(true);
+    return &stats;
+}
+
+// Created before any thread counters, so it is destroyed after all of them
+// have been merged into it.
+OpcodeStats* OpcodeStats::total()
+{
+    struct Total
+    {
+        OpcodeStats stats;
+        ~Total()
+        {
+            stats.print(std::cerr);
+        }
+    };
+
+    static Total total;
+    return &total.stats;
+}
+
+void OpcodeStats::enter()
+{
+    prev_ = OPCODES;
+    last_ = now();
+}
+
+void OpcodeStats::leave()
+{
+    attribute(now());
+    prev_ = OPCODES;
+}
+
+uint64_t OpcodeStats::count(Opcode op) const
+{
+    return counts_[static_cast<uint8_t>(op)];
+}
+
+uint64_t OpcodeStats::pairCount(Opcode first, Opcode second) const
+{
+    return pairs_[static_cast<uint8_t>(first) * OPCODES + static_cast<uint8_t>(second)];
+}
+
+void OpcodeStats::merge(const OpcodeStats& other)
+{
+    for (size_t i = 0; i < OPCODES; i++)
+    {
+        counts_[i] += other.counts_[i];
+        cycles_[i] += other.cycles_[i];
+    }
+    for (size_t i = 0; i < OPCODES * OPCODES; i++)
+    {
+        pairs_[i] += other.pairs_[i];
+    }
+}
+
+void OpcodeStats::reset()
+{
+    std::fill(counts_.begin(), counts_.end(), 0);
+    std::fill(cycles_.begin(), cycles_.end(), 0);
+    std::fill(pairs_.begin(), pairs_.end(), 0);
+    prev_ = OPCODES;
+}
+
+void OpcodeStats::print(std::ostream& os, size_t top_pairs) const
+{
+    uint64_t total_count = 0;
+    std::vector<size_t> ops;
+    for (size_t i = 0; i < OPCODES; i++)
+    {
+        total_count += counts_[i];
+        if (counts_[i])
+        {
+            ops.push_back(i);
+        }
+    }
+    if (total_count == 0)
+    {
+        return;
+    }
+    std::sort(ops.begin(), ops.end(), [this](size_t lhs, size_t rhs) { return counts_[lhs] > counts_[rhs]; });
+
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-16s %14s %7s %16s %10s\n", "Opcode", "Count", "%", "Cycles", "Cycles/op");
+    os << line;
+    for (size_t op : ops)
+    {
+        std::snprintf(line, sizeof(line), "%-16s %14" PRIu64 " %6.2f%% %16" PRIu64 " %10.1f\n", opcodeName(op),
+            counts_[op], 100.0 * static_cast<double>(counts_[op]) / static_cast<double>(total_count), cycles_[op],
+            static_cast<double>(cycles_[op]) / static_cast<double>(counts_[op]));
+        os << line;
+    }
+
+    std::vector<size_t> pairs;
+    for (size_t i = 0; i < OPCODES * OPCODES; i++)
+    {
+        if (pairs_[i])
+        {
+            pairs.push_back(i);
+        }
+    }
+    size_t shown = std::min(top_pairs, pairs.size());
+    std::partial_sort(pairs.begin(), pairs.begin() + static_cast<std::ptrdiff_t>(shown), pairs.end(),
+        [this](size_t lhs, size_t rhs) { return pairs_[lhs] > pairs_[rhs]; });
+
+    std::snprintf(line, sizeof(line), "\n%-34s %14s %7s\n", "Pair", "Count", "%");
+    os << line;
+    for (size_t i = 0; i < shown; i++)
+    {
+        std::string pair = std::string(opcodeName(pairs[i] / OPCODES)) + " -> " + opcodeName(pairs[i] % OPCODES);
+        std::snprintf(line, sizeof(line), "%-34s %14" PRIu64 " %6.2f%%\n", pair.c_str(), pairs_[pairs[i]],
+            100.0 * static_cast<double>(pairs_[pairs[i]]) / static_cast<double>(total_count));
+        os << line;
+    }
+}
+
+OpcodeStats::Scope::Scope()
+{
+    OpcodeStats::local()->enter();
+}
+
+OpcodeStats::Scope::~Scope()
+{
+    OpcodeStats::local()->leave();
+}
+
+#endif // VM_OPCODE_STATS
\ No newline at end of file
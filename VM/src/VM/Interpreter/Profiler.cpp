@@ -0,0 +1,144 @@
+#include "VM/Interpreter/Profiler.h"
+#include "Opcodes.h"
+#include "VM/Pkm/PkmClass.h"
+
+#include <csignal>
+#include <map>
+#include <string>
+#include <sys/time.h>
+
+std::atomic<Profiler*> Profiler::running_ = nullptr;
+thread_local Frame* volatile Profiler::top_ = nullptr;
+
+Profiler::Profiler(long interval_us, size_t capacity) : interval_us_(interval_us), entries_(capacity) {}
+
+Profiler::~Profiler()
+{
+    stop();
+}
+
+int Profiler::start()
+{
+    Profiler* expected = nullptr;
+    if (!running_.compare_exchange_strong(expected, this))
+    {
+        return ALREADY_RUNNING;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    itimerval timer = {{0, interval_us_}, {0, interval_us_}};
+    if ((sigaction(SIGPROF, &action, nullptr) != 0) || (setitimer(ITIMER_PROF, &timer, nullptr) != 0))
+    {
+        running_ = nullptr;
+        return TIMER_NOT_SET;
+    }
+    return OK;
+}
+
+void Profiler::stop()
+{
+    if (running_.load() != this)
+    {
+        return;
+    }
+
+    itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    signal(SIGPROF, SIG_IGN);
+    running_ = nullptr;
+}
+
+size_t Profiler::samples() const
+{
+    return samples_.load();
+}
+
+size_t Profiler::dropped() const
+{
+    return dropped_.load();
+}
+
+void Profiler::onSignal(int)
+{
+    Profiler* profiler = running_.load();
+    if (profiler)
+    {
+        profiler->sample();
+    }
+}
+
+// A sample is stored leaf first and closed by an entry without a method
+// that holds its depth.
+void Profiler::sample()
+{
+    Frame* frame = top_;
+    std::atomic_signal_fence(std::memory_order_acquire);
+    if (!frame)
+    {
+        return;
+    }
+
+    Entry stack[MAX_DEPTH];
+    size_t depth = 0;
+    for (; frame && (depth < MAX_DEPTH); frame = frame->prev, depth++)
+    {
+        const PkmMethod* method = frame->method;
+        const auto* code = reinterpret_cast<const uint8_t*>(method->cls->bytecode.data()) + method->offset;
+        auto offset = static_cast<uint32_t>(frame->pc - code);
+        // Callers have already stepped past their call instruction.
+        stack[depth] = {method, (depth == 0) ? offset : offset - INSTRUCTION_SIZE};
+    }
+
+    size_t pos = used_.fetch_add(depth + 1);
+    if (pos + depth + 1 > entries_.size())
+    {
+        used_.fetch_sub(depth + 1);
+        dropped_++;
+        return;
+    }
+
+    for (size_t i = 0; i < depth; i++)
+    {
+        entries_[pos + i] = stack[i];
+    }
+    entries_[pos + depth] = {nullptr, static_cast<uint32_t>(depth)};
+    samples_++;
+}
+
+static std::string frameName(const PkmMethod* method)
+{
+    const auto* name = static_cast<const StringType*>(method->cls->const_pool[method->name].get());
+    return method->cls->name + "." + name->value;
+}
+
+void Profiler::writeFolded(std::ostream& os) const
+{
+    std::map<std::string, size_t> stacks;
+    size_t begin = 0;
+    size_t used = std::min(used_.load(), entries_.size());
+    for (size_t pos = 0; pos < used; pos++)
+    {
+        if (entries_[pos].method)
+        {
+            continue;
+        }
+
+        std::string stack;
+        for (size_t i = pos; i > begin; i--)
+        {
+            const Entry& entry = entries_[i - 1];
+            stack += (stack.empty() ? "" : ";") + frameName(entry.method) + ":" + std::to_string(entry.offset);
+        }
+        stacks[stack]++;
+        begin = pos + 1;
+    }
+
+    for (const auto& [stack, count] : stacks)
+    {
+        os << stack << " " << count << "\n";
+    }
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "VM/Klass/KlassLoader.h"
+#include "VM/Trace/Tracer.h"
 
 #include <filesystem>
 #include <fstream>
@@ -6,6 +7,8 @@
 
 void KlassLoader::loadLib(const char* folder)
 {
+    Tracer::Scope trace("load", "loadLib");
+    trace.detail(folder);
     for (const auto& entry : std::filesystem::directory_iterator(folder))
     {
         std::ifstream klass_file(entry.path().string());
@@ -20,6 +23,7 @@ void KlassLoader::loadLib(const char* folder)
 
 int KlassLoader::loadUser(int argc, char* argv[])
 {
+    Tracer::Scope trace("load", "loadUser");
     for (int i = 1; i < argc; i++)
     {
         std::ifstream klass_file(argv[i]);
@@ -0,0 +1,165 @@
+#include "VM/Metrics/Metrics.h"
+
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::atomic<Metrics::Segment*> Metrics::current_ = nullptr;
+
+Metrics::~Metrics()
+{
+    close();
+}
+
+int Metrics::open(const std::string& name)
+{
+    if (segment_)
+    {
+        return ALREADY_OPENED;
+    }
+
+    std::string segment_name = name.empty() ? defaultName(getpid()) : name;
+    int fd = shm_open(segment_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return SEGMENT_NOT_OPENED;
+    }
+
+    void* region = MAP_FAILED;
+    if (ftruncate(fd, sizeof(Segment)) == 0)
+    {
+        region = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (region == MAP_FAILED)
+    {
+        shm_unlink(segment_name.c_str());
+        return SEGMENT_NOT_OPENED;
+    }
+
+    // The new segment is zero filled; readers ignore it until the magic is set.
+    segment_ = new (region) Segment {};
+    segment_->version = VERSION;
+    segment_->size = sizeof(Segment);
+    segment_->pid = static_cast<uint32_t>(getpid());
+    segment_->magic.store(MAGIC, std::memory_order_release);
+
+    name_ = segment_name;
+    current_ = segment_;
+    return OK;
+}
+
+void Metrics::close()
+{
+    if (!segment_)
+    {
+        return;
+    }
+
+    Segment* expected = segment_;
+    current_.compare_exchange_strong(expected, nullptr);
+    munmap(segment_, sizeof(Segment));
+    shm_unlink(name_.c_str());
+    segment_ = nullptr;
+}
+
+std::string Metrics::defaultName(pid_t pid)
+{
+    return "/pkm-vm." + std::to_string(pid);
+}
+
+MetricsReader::~MetricsReader()
+{
+    close();
+}
+
+int MetricsReader::open(const std::string& name)
+{
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return Metrics::SEGMENT_NOT_OPENED;
+    }
+
+    struct stat st = {};
+    void* region = MAP_FAILED;
+    if ((fstat(fd, &st) == 0) && (static_cast<size_t>(st.st_size) >= sizeof(Metrics::Segment)))
+    {
+        region = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (region == MAP_FAILED)
+    {
+        return Metrics::WRONG_SEGMENT;
+    }
+
+    segment_ = static_cast<const Metrics::Segment*>(region);
+    size_ = static_cast<size_t>(st.st_size);
+    if ((segment_->magic.load(std::memory_order_acquire) != Metrics::MAGIC) ||
+        (segment_->version != Metrics::VERSION) || (segment_->size < sizeof(Metrics::Segment)))
+    {
+        close();
+        return Metrics::WRONG_SEGMENT;
+    }
+    return Metrics::OK;
+}
+
+void MetricsReader::close()
+{
+    if (segment_)
+    {
+        munmap(const_cast<Metrics::Segment*>(segment_), size_);
+        segment_ = nullptr;
+        size_ = 0;
+    }
+}
+
+const Metrics::Segment* MetricsReader::segment() const
+{
+    return segment_;
+}
+
+static void printCounter(std::ostream& os, const char* name, const char* type, const Metrics::Counter& counter)
+{
+    os << "# TYPE " << name << " " << type << "\n" << name << " " << counter.load(std::memory_order_relaxed) << "\n";
+}
+
+void MetricsReader::print(std::ostream& os) const
+{
+    if (!segment_)
+    {
+        return;
+    }
+
+    os << "# pid " << segment_->pid << "\n";
+    printCounter(os, "pkm_stack_reserved_bytes_total", "counter", segment_->stack_reserved_bytes);
+    printCounter(os, "pkm_gc_total", "counter", segment_->gc_count);
+
+    os << "# TYPE pkm_gc_pause_microseconds histogram\n";
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < Metrics::GC_PAUSE_BUCKETS; i++)
+    {
+        cumulative += segment_->gc_pause_us[i].load(std::memory_order_relaxed);
+        os << "pkm_gc_pause_microseconds_bucket{le=\"";
+        if (i + 1 < Metrics::GC_PAUSE_BUCKETS)
+        {
+            os << (uint64_t(1) << i);
+        }
+        else
+        {
+            os << "+Inf";
+        }
+        os << "\"} " << cumulative << "\n";
+    }
+    os << "pkm_gc_pause_microseconds_sum " << segment_->gc_pause_us_sum.load(std::memory_order_relaxed) << "\n";
+    os << "pkm_gc_pause_microseconds_count " << cumulative << "\n";
+
+    printCounter(os, "pkm_classes_linked_total", "counter", segment_->classes_linked);
+    printCounter(os, "pkm_methods_linked_total", "counter", segment_->methods_linked);
+    printCounter(os, "pkm_instructions_executed_total", "counter", segment_->instructions_executed);
+    printCounter(os, "pkm_pni_calls_total", "counter", segment_->pni_calls);
+}
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "VM/PNIEnv.h"
+#include "VM/Heap/HeapDumper.h"
+#include "VM/Metrics/Metrics.h"
+#include "VM/Trace/Tracer.h"
 
 PNIEnv::PNIEnv(PkmVM* pvm) : pvm_(pvm) {}
 
@@ -9,6 +12,9 @@ void PNIEnv::loadClasses(PkmClasses* pclasses)
 
 pclass PNIEnv::findClass(const std::string& class_name)
 {
+    Metrics::add(&Metrics::Segment::pni_calls);
+    Tracer::Scope trace("pni", "findClass");
+    trace.detail(class_name);
     if (classes_.contains(class_name))
     {
         return &classes_[class_name];
@@ -19,6 +25,7 @@ pclass PNIEnv::findClass(const std::string& class_name)
 
 pmethodID PNIEnv::getMethodID(pclass cls, const std::string& met_name)
 {
+    Metrics::add(&Metrics::Segment::pni_calls);
     if (cls->methods.contains(met_name))
     {
         return &cls->methods[met_name];
@@ -27,6 +34,21 @@ pmethodID PNIEnv::getMethodID(pclass cls, const std::string& met_name)
     return nullptr;
 }
 
-void PNIEnv::callMethod(pclass, pmethodID)
+int PNIEnv::callMethod(pclass, pmethodID mid, const std::vector<PkmValue>& args, PkmValue* result)
 {
+    Metrics::add(&Metrics::Segment::pni_calls);
+    Tracer::Scope trace("pni", "callMethod");
+    if (Tracer::enabled())
+    {
+        trace.detail(static_cast<const StringType*>(mid->cls->const_pool[mid->name].get())->value);
+    }
+    return Interpreter::execute(mid, args, result);
+}
+
+int PNIEnv::dumpHeap(const std::string& file_name) const
+{
+    Metrics::add(&Metrics::Segment::pni_calls);
+    Tracer::Scope trace("pni", "dumpHeap");
+    trace.detail(file_name);
+    return HeapDumper::dump(classes_, file_name);
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "VM/Perf/PerfMap.h"
+
+#include <ctime>
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const uint32_t JITDUMP_MAGIC = 0x4A695444;
+static const uint32_t JITDUMP_VERSION = 1;
+static const uint32_t JIT_CODE_LOAD = 0;
+static const uint32_t JIT_CODE_CLOSE = 3;
+
+#if defined(__x86_64__)
+static const uint32_t ELF_MACHINE = EM_X86_64;
+#elif defined(__aarch64__)
+static const uint32_t ELF_MACHINE = EM_AARCH64;
+#else
+static const uint32_t ELF_MACHINE = EM_NONE;
+#endif
+
+struct JitHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t elf_mach;
+    uint32_t pad1;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+};
+
+struct JitRecordHeader
+{
+    uint32_t id;
+    uint32_t total_size;
+    uint64_t timestamp;
+};
+
+struct JitCodeLoad
+{
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t code_addr;
+    uint64_t code_size;
+    uint64_t code_index;
+};
+
+// perf record -k mono stamps samples with the same clock.
+static uint64_t timestamp()
+{
+    timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+PerfMap::~PerfMap()
+{
+    close();
+}
+
+int PerfMap::open(bool jitdump, const std::string& dir)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string pid = std::to_string(getpid());
+    map_ = std::fopen((dir + "/perf-" + pid + ".map").c_str(), "w");
+    if (!map_)
+    {
+        return FILE_NOT_OPENED;
+    }
+    if (!jitdump)
+    {
+        return OK;
+    }
+
+    dump_ = std::fopen((dir + "/jit-" + pid + ".dump").c_str(), "w+");
+    if (!dump_)
+    {
+        return FILE_NOT_OPENED;
+    }
+
+    // perf finds the dump through this executable mapping of it.
+    marker_size_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    marker_ = mmap(nullptr, marker_size_, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(dump_), 0);
+    if (marker_ == MAP_FAILED)
+    {
+        marker_ = nullptr;
+    }
+
+    JitHeader header = {JITDUMP_MAGIC, JITDUMP_VERSION, sizeof(JitHeader), ELF_MACHINE, 0,
+        static_cast<uint32_t>(getpid()), timestamp(), 0};
+    std::fwrite(&header, sizeof(header), 1, dump_);
+    std::fflush(dump_);
+    return OK;
+}
+
+void PerfMap::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dump_)
+    {
+        writeRecord(JIT_CODE_CLOSE, nullptr, 0, nullptr, 0);
+        if (marker_)
+        {
+            munmap(marker_, marker_size_);
+            marker_ = nullptr;
+        }
+        std::fclose(dump_);
+        dump_ = nullptr;
+    }
+    if (map_)
+    {
+        std::fclose(map_);
+        map_ = nullptr;
+    }
+}
+
+bool PerfMap::is_open() const
+{
+    return map_ != nullptr;
+}
+
+void PerfMap::addCode(const void* start, size_t size, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!map_ || (size == 0))
+    {
+        return;
+    }
+
+    std::fprintf(map_, "%lx %zx %s\n", reinterpret_cast<unsigned long>(start), size, name.c_str());
+    std::fflush(map_);
+
+    if (dump_)
+    {
+        auto addr = reinterpret_cast<uint64_t>(start);
+        JitCodeLoad load = {static_cast<uint32_t>(getpid()), static_cast<uint32_t>(syscall(SYS_gettid)), addr, addr,
+            size, code_index_++};
+        std::string body(reinterpret_cast<const char*>(&load), sizeof(load));
+        body.append(name.c_str(), name.size() + 1);
+        writeRecord(JIT_CODE_LOAD, body.data(), body.size(), start, size);
+    }
+}
+
+void PerfMap::writeRecord(uint32_t id, const void* body, size_t body_size, const void* tail, size_t tail_size)
+{
+    JitRecordHeader header = {id, static_cast<uint32_t>(sizeof(JitRecordHeader) + body_size + tail_size),
+        timestamp()};
+    std::fwrite(&header, sizeof(header), 1, dump_);
+    if (body_size)
+    {
+        std::fwrite(body, body_size, 1, dump_);
+    }
+    if (tail_size)
+    {
+        std::fwrite(tail, tail_size, 1, dump_);
+    }
+    std::fflush(dump_);
+}
\ No newline at end of file
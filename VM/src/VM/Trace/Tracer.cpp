@@ -0,0 +1,214 @@
+#include "VM/Trace/Tracer.h"
+
+#include <array>
+#include <cstdio>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+std::atomic<bool> Tracer::enabled_ = false;
+std::atomic<Tracer*> Tracer::running_ = nullptr;
+std::atomic<size_t> Tracer::dropped_ = 0;
+std::mutex Tracer::rings_mutex_;
+
+// Written by its thread only; head and tail are published with
+// release/acquire so the flusher reads whole events.
+struct Tracer::Ring
+{
+    std::array<Event, RING_SIZE> events;
+    std::atomic<size_t> head = 0;
+    std::atomic<size_t> tail = 0;
+    uint32_t tid = 0;
+};
+
+// Rings outlive their threads so events are not lost when a thread exits
+// before the next flush.
+std::vector<std::unique_ptr<Tracer::Ring>>& Tracer::rings()
+{
+    static std::vector<std::unique_ptr<Ring>> all;
+    return all;
+}
+
+Tracer::Ring* Tracer::localRing()
+{
+    thread_local Ring* ring = nullptr;
+    if (!ring)
+    {
+        auto owned = std::make_unique<Ring>();
+        owned->tid = static_cast<uint32_t>(syscall(SYS_gettid));
+        ring = owned.get();
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings().push_back(std::move(owned));
+    }
+    return ring;
+}
+
+uint64_t Tracer::now()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void Tracer::setDetail(Event* event, const std::string& text)
+{
+    size_t size = std::min(text.size(), DETAIL_SIZE - 1);
+    text.copy(event->detail, size);
+    event->detail[size] = '\0';
+}
+
+void Tracer::push(const Event& event)
+{
+    Ring* ring = localRing();
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) == RING_SIZE)
+    {
+        dropped_++;
+        return;
+    }
+    ring->events[head % RING_SIZE] = event;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::instant(const char* category, const char* name, const std::string& detail)
+{
+    if (enabled())
+    {
+        Event event = {now(), 0, category, name, {}};
+        setDetail(&event, detail);
+        push(event);
+    }
+}
+
+Tracer::Tracer(std::chrono::milliseconds flush_interval) : flush_interval_(flush_interval) {}
+
+Tracer::~Tracer()
+{
+    stop();
+}
+
+int Tracer::start(const std::string& file_name)
+{
+    Tracer* expected = nullptr;
+    if (!running_.compare_exchange_strong(expected, this))
+    {
+        return ALREADY_RUNNING;
+    }
+
+    file_.open(file_name);
+    if (!file_.is_open())
+    {
+        running_ = nullptr;
+        return FILE_NOT_OPENED;
+    }
+    file_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    // Events left over from an earlier tracer are not part of this trace.
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto& ring : rings())
+        {
+            ring->tail.store(ring->head.load());
+        }
+    }
+
+    stopping_ = false;
+    written_ = 0;
+    enabled_ = true;
+    flusher_ = std::thread(&Tracer::flushLoop, this);
+    return OK;
+}
+
+void Tracer::stop()
+{
+    if (running_.load() != this)
+    {
+        return;
+    }
+
+    enabled_ = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_one();
+    flusher_.join();
+
+    flush();
+    file_ << "\n]}\n";
+    file_.close();
+    running_ = nullptr;
+}
+
+size_t Tracer::written() const
+{
+    return written_;
+}
+
+size_t Tracer::dropped() const
+{
+    return dropped_.load();
+}
+
+void Tracer::flushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_)
+    {
+        wakeup_.wait_for(lock, flush_interval_);
+        flush();
+    }
+}
+
+static void writeEscaped(std::ostream& os, const char* text)
+{
+    for (; *text; text++)
+    {
+        if ((*text == '"') || (*text == '\\'))
+        {
+            os << '\\' << *text;
+        }
+        else if (static_cast<unsigned char>(*text) >= 0x20)
+        {
+            os << *text;
+        }
+    }
+}
+
+// Only the flusher thread, or stop() after joining it, calls this.
+void Tracer::flush()
+{
+    std::vector<Ring*> all;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto& ring : rings())
+        {
+            all.push_back(ring.get());
+        }
+    }
+
+    static const uint32_t pid = static_cast<uint32_t>(getpid());
+    char time[64];
+    for (Ring* ring : all)
+    {
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        size_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+        {
+            const Event& event = ring->events[tail % RING_SIZE];
+            file_ << (written_++ ? ",\n" : "\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                  << "\",\"ph\":\"" << (event.duration ? "X" : "i") << "\",";
+            std::snprintf(time, sizeof(time), "\"ts\":%.3f,\"dur\":%.3f,", static_cast<double>(event.start) / 1000,
+                static_cast<double>(event.duration) / 1000);
+            file_ << time << "\"pid\":" << pid << ",\"tid\":" << ring->tid;
+            if (event.detail[0])
+            {
+                file_ << ",\"args\":{\"detail\":\"";
+                writeEscaped(file_, event.detail);
+                file_ << "\"}";
+            }
+            file_ << "}";
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    file_.flush();
+}
\ No newline at end of file
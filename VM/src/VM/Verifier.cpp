@@ -0,0 +1,589 @@
+#include "VM/Verifier.h"
+#include "Opcodes.h"
+
+#include <algorithm>
+#include <cstring>
+
+Verifier::Verifier(PkmClasses* classes) : classes_(classes) {}
+
+bool Verifier::verify()
+{
+    for (auto& [class_name, cls] : *classes_)
+    {
+        verifyClass(class_name, &cls);
+    }
+    return !err();
+}
+
+std::vector<std::string>* Verifier::getErrors()
+{
+    return &errors_;
+}
+
+void Verifier::printErrors(std::ostream& os) const
+{
+    for (const auto& err : errors_)
+    {
+        os << err << "\n";
+    }
+}
+
+bool Verifier::err() const
+{
+    return !errors_.empty();
+}
+
+PkmClass* Verifier::resolveOwner(PkmClasses* classes, const std::string& class_name, const std::string& ref,
+    std::string* member_name)
+{
+    std::string owner = class_name;
+    *member_name = ref;
+
+    size_t dot = ref.rfind('.');
+    if (dot != std::string::npos)
+    {
+        owner = ref.substr(0, dot);
+        *member_name = ref.substr(dot + 1);
+    }
+
+    auto cls = classes->find(owner);
+    return (cls == classes->end()) ? nullptr : &cls->second;
+}
+
+PkmMethod* Verifier::resolveMethod(PkmClasses* classes, const std::string& class_name, const std::string& method_ref)
+{
+    std::string method_name;
+    PkmClass* cls = resolveOwner(classes, class_name, method_ref, &method_name);
+    if (!cls)
+    {
+        return nullptr;
+    }
+
+    auto method = cls->methods.find(method_name);
+    if (method == cls->methods.end())
+    {
+        return nullptr;
+    }
+
+    return &method->second;
+}
+
+PkmField* Verifier::resolveField(PkmClasses* classes, const std::string& class_name, const std::string& field_ref,
+    PkmClass** owner)
+{
+    std::string field_name;
+    PkmClass* cls = resolveOwner(classes, class_name, field_ref, &field_name);
+    if (!cls)
+    {
+        return nullptr;
+    }
+
+    auto field = cls->fields.find(field_name);
+    if (field == cls->fields.end())
+    {
+        return nullptr;
+    }
+
+    if (owner)
+    {
+        *owner = cls;
+    }
+    return &field->second;
+}
+
+bool Verifier::verifyClass(const std::string& class_name, PkmClass* cls)
+{
+    class_name_ = &class_name;
+    cls_ = cls;
+
+    std::vector<uint32_t> offsets;
+    for (const auto& [method_name, method] : cls->methods)
+    {
+        offsets.push_back(method.offset);
+    }
+    std::sort(offsets.begin(), offsets.end());
+
+    bool ok = true;
+    for (auto& [method_name, method] : cls->methods)
+    {
+        auto next = std::upper_bound(offsets.begin(), offsets.end(), method.offset);
+        uint32_t end = (next == offsets.end()) ? static_cast<uint32_t>(cls->bytecode.size()) : *next;
+        ok = verifyMethod(method_name, &method, end) && ok;
+    }
+    return ok;
+}
+
+bool Verifier::verifyMethod(const std::string& method_name, PkmMethod* method, uint32_t end)
+{
+    method_name_ = &method_name;
+    method_ = method;
+    begin_ = method->offset;
+    end_ = end;
+
+    if ((begin_ >= end_) || (end_ > cls_->bytecode.size()) || ((end_ - begin_) % INSTRUCTION_SIZE != 0))
+    {
+        pushError("method code is out of bytecode bounds", begin_);
+        return false;
+    }
+
+    if (method->met_params.size() > method->locals_num)
+    {
+        pushError("locals number " + std::to_string(static_cast<uint32_t>(method->locals_num)) + " is less than parameters number", begin_);
+        return false;
+    }
+
+    locals_.assign(method->locals_num, VariableType::VOID);
+    for (size_t i = 0; i < method->met_params.size(); i++)
+    {
+        locals_[i] = stackType(method->met_params[i]);
+    }
+
+    size_t instr_num = (end_ - begin_) / INSTRUCTION_SIZE;
+    std::vector<bool> targets(instr_num, false);
+    starts_.assign(instr_num, false);
+    states_.assign(instr_num, std::nullopt);
+    stack_.clear();
+
+    for (uint32_t pos = begin_; pos < end_; pos += instructionSize(&cls_->bytecode[pos]))
+    {
+        if (instructionSize(&cls_->bytecode[pos]) > end_ - pos)
+        {
+            pushError("switch table is out of method bounds", pos);
+            return false;
+        }
+        starts_[(pos - begin_) / INSTRUCTION_SIZE] = true;
+    }
+
+    for (uint32_t pos = begin_; pos < end_; pos += instructionSize(&cls_->bytecode[pos]))
+    {
+        std::vector<int32_t> offsets = branchOffsets(pos);
+        for (int32_t offset : offsets)
+        {
+            if (!checkBranch(pos, offset))
+            {
+                return false;
+            }
+            targets[(pos + offset - begin_) / INSTRUCTION_SIZE] = true;
+        }
+    }
+
+    bool falls = true;
+    for (uint32_t pos = begin_; pos < end_; pos += instructionSize(&cls_->bytecode[pos]))
+    {
+        size_t ind = (pos - begin_) / INSTRUCTION_SIZE;
+        if (!falls && !targets[ind])
+        {
+            continue;
+        }
+
+        if (states_[ind])
+        {
+            if (falls && (stack_ != *states_[ind]))
+            {
+                pushError("inconsistent operand stack at branch target", pos);
+                return false;
+            }
+            stack_ = *states_[ind];
+        }
+        else if (!falls)
+        {
+            stack_.clear();
+        }
+
+        if (targets[ind])
+        {
+            states_[ind] = stack_;
+        }
+
+        auto op = static_cast<uint8_t>(cls_->bytecode[pos]);
+        uint16_t arg = 0;
+        std::memcpy(&arg, &cls_->bytecode[pos + 2], sizeof(arg));
+
+        pos_ = pos;
+        if (!verifyInstruction(pos, op, arg))
+        {
+            return false;
+        }
+
+        switch (static_cast<Opcode>(op))
+        {
+        case Opcode::GOTO:
+        case Opcode::TABLESWITCH:
+        case Opcode::LOOKUPSWITCH:
+        case Opcode::IRETURN:
+        case Opcode::LRETURN:
+        case Opcode::FRETURN:
+        case Opcode::DRETURN:
+        case Opcode::ARETURN:
+        case Opcode::RETURN:
+            falls = false;
+            break;
+        default:
+            falls = true;
+            break;
+        }
+    }
+
+    if (falls)
+    {
+        pushError("control falls off the end of method", end_ - INSTRUCTION_SIZE);
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<int32_t> Verifier::branchOffsets(uint32_t pos) const
+{
+    auto op = static_cast<Opcode>(static_cast<uint8_t>(cls_->bytecode[pos]));
+    uint16_t arg = 0;
+    std::memcpy(&arg, &cls_->bytecode[pos + 2], sizeof(arg));
+
+    auto word = [this, pos](uint32_t ind) {
+        int32_t value = 0;
+        std::memcpy(&value, &cls_->bytecode[pos + INSTRUCTION_SIZE * (ind + 1)], sizeof(value));
+        return value;
+    };
+
+    std::vector<int32_t> offsets;
+    if (((op >= Opcode::IFEQ) && (op <= Opcode::GOTO)) || ((op >= Opcode::IF_ICMPEQ) && (op <= Opcode::IF_ICMPLE)))
+    {
+        offsets.push_back(static_cast<int16_t>(arg));
+    }
+    else if (op == Opcode::TABLESWITCH)
+    {
+        offsets.push_back(word(0));
+        for (uint32_t i = 0; i < arg; i++)
+        {
+            offsets.push_back(word(2 + i));
+        }
+    }
+    else if (op == Opcode::LOOKUPSWITCH)
+    {
+        offsets.push_back(word(0));
+        for (uint32_t i = 0; i < arg; i++)
+        {
+            offsets.push_back(word(2 + 2 * i));
+        }
+    }
+    return offsets;
+}
+
+// Lookup keys must be strictly ascending for the interpreter's binary search.
+bool Verifier::checkLookupKeys(uint32_t pos, uint16_t num)
+{
+    for (uint32_t i = 1; i < num; i++)
+    {
+        int32_t prev = 0;
+        int32_t key = 0;
+        std::memcpy(&prev, &cls_->bytecode[pos + INSTRUCTION_SIZE * (2 * i)], sizeof(prev));
+        std::memcpy(&key, &cls_->bytecode[pos + INSTRUCTION_SIZE * (2 * i + 2)], sizeof(key));
+        if (key <= prev)
+        {
+            pushError("lookup switch keys are not sorted", pos);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Verifier::checkBranch(uint32_t pos, int32_t offset)
+{
+    int64_t target = static_cast<int64_t>(pos) + offset;
+    if ((target < begin_) || (target >= end_) || (offset % static_cast<int32_t>(INSTRUCTION_SIZE) != 0) ||
+        !starts_[static_cast<size_t>(target - begin_) / INSTRUCTION_SIZE])
+    {
+        pushError("branch target " + std::to_string(target) + " is outside of method", pos);
+        return false;
+    }
+    return true;
+}
+
+bool Verifier::verifyInstruction(uint32_t pos, uint8_t op, uint16_t arg)
+{
+    const VariableType INT = VariableType::INT;
+    const VariableType LONG = VariableType::LONG;
+    const VariableType FLOAT = VariableType::FLOAT;
+    const VariableType DOUBLE = VariableType::DOUBLE;
+    const VariableType REF = VariableType::REFERENCE;
+
+    // Binary operations pop the left operand first: it is evaluated last by the translator.
+    auto binary = [this](VariableType lhs, VariableType rhs, VariableType res) {
+        return pop(lhs) && pop(rhs) && push(res);
+    };
+    auto unary = [this](VariableType operand, VariableType res) {
+        return pop(operand) && push(res);
+    };
+
+    size_t errors_num = errors_.size();
+    bool ok = false;
+    switch (static_cast<Opcode>(op))
+    {
+    case Opcode::NOP:
+        ok = true;
+        break;
+
+    case Opcode::LDC:
+    {
+        const AbstractType* cst = constant(arg);
+        if (cst && (cst->type() == AbstractType::Type::INTEGER))
+        {
+            ok = push(INT);
+        }
+        else if (cst && (cst->type() == AbstractType::Type::FLOAT))
+        {
+            ok = push(FLOAT);
+        }
+        else
+        {
+            pushError("constant #" + std::to_string(static_cast<uint32_t>(arg)) + " can not be loaded", pos);
+            return false;
+        }
+        break;
+    }
+
+    case Opcode::ILOAD: ok = load(arg, INT); break;
+    case Opcode::LLOAD: ok = load(arg, LONG); break;
+    case Opcode::FLOAD: ok = load(arg, FLOAT); break;
+    case Opcode::DLOAD: ok = load(arg, DOUBLE); break;
+    case Opcode::ALOAD: ok = load(arg, REF); break;
+
+    case Opcode::ISTORE: ok = store(arg, INT); break;
+    case Opcode::LSTORE: ok = store(arg, LONG); break;
+    case Opcode::FSTORE: ok = store(arg, FLOAT); break;
+    case Opcode::DSTORE: ok = store(arg, DOUBLE); break;
+    case Opcode::ASTORE: ok = store(arg, REF); break;
+
+    case Opcode::POP: ok = popAny(); break;
+    case Opcode::POP2: ok = popAny() && popAny(); break;
+    case Opcode::DUP:
+    {
+        VariableType top = VariableType::VOID;
+        ok = popAny(&top) && push(top) && push(top);
+        break;
+    }
+    case Opcode::DUP2:
+    {
+        VariableType top = VariableType::VOID;
+        VariableType next = VariableType::VOID;
+        ok = popAny(&top) && popAny(&next) && push(next) && push(top) && push(next) && push(top);
+        break;
+    }
+
+    case Opcode::IADD: case Opcode::ISUB: case Opcode::IMUL: case Opcode::IDIV: case Opcode::IREM:
+    case Opcode::ISHL: case Opcode::ISHR: case Opcode::IAND: case Opcode::IOR: case Opcode::IXOR:
+        ok = binary(INT, INT, INT);
+        break;
+    case Opcode::LADD: case Opcode::LSUB: case Opcode::LMUL: case Opcode::LDIV: case Opcode::LREM:
+    case Opcode::LAND: case Opcode::LOR: case Opcode::LXOR:
+        ok = binary(LONG, LONG, LONG);
+        break;
+    case Opcode::LSHL: case Opcode::LSHR:
+        ok = binary(LONG, INT, LONG);
+        break;
+    case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV: case Opcode::FREM:
+        ok = binary(FLOAT, FLOAT, FLOAT);
+        break;
+    case Opcode::DADD: case Opcode::DSUB: case Opcode::DMUL: case Opcode::DDIV: case Opcode::DREM:
+        ok = binary(DOUBLE, DOUBLE, DOUBLE);
+        break;
+
+    case Opcode::INEG: ok = unary(INT, INT); break;
+    case Opcode::LNEG: ok = unary(LONG, LONG); break;
+    case Opcode::FNEG: ok = unary(FLOAT, FLOAT); break;
+    case Opcode::DNEG: ok = unary(DOUBLE, DOUBLE); break;
+    case Opcode::IINC: ok = local(arg, INT); break;
+
+    case Opcode::I2L: ok = unary(INT, LONG); break;
+    case Opcode::I2F: ok = unary(INT, FLOAT); break;
+    case Opcode::I2D: ok = unary(INT, DOUBLE); break;
+    case Opcode::L2I: ok = unary(LONG, INT); break;
+    case Opcode::L2F: ok = unary(LONG, FLOAT); break;
+    case Opcode::L2D: ok = unary(LONG, DOUBLE); break;
+    case Opcode::F2I: ok = unary(FLOAT, INT); break;
+    case Opcode::F2L: ok = unary(FLOAT, LONG); break;
+    case Opcode::F2D: ok = unary(FLOAT, DOUBLE); break;
+    case Opcode::D2I: ok = unary(DOUBLE, INT); break;
+    case Opcode::D2L: ok = unary(DOUBLE, LONG); break;
+    case Opcode::D2F: ok = unary(DOUBLE, FLOAT); break;
+    case Opcode::I2B: case Opcode::I2C: case Opcode::I2S: ok = unary(INT, INT); break;
+
+    case Opcode::ICMP: ok = binary(INT, INT, INT); break;
+    case Opcode::LCMP: ok = binary(LONG, LONG, INT); break;
+    case Opcode::FCMPL: case Opcode::FCMPG: ok = binary(FLOAT, FLOAT, INT); break;
+    case Opcode::DCMPL: case Opcode::DCMPG: ok = binary(DOUBLE, DOUBLE, INT); break;
+
+    case Opcode::IFEQ: case Opcode::IFNE: case Opcode::IFLT:
+    case Opcode::IFGE: case Opcode::IFGT: case Opcode::IFLE:
+        ok = pop(INT) && mergeBranch(pos, static_cast<int16_t>(arg));
+        break;
+    case Opcode::IF_ICMPEQ: case Opcode::IF_ICMPNE: case Opcode::IF_ICMPLT:
+    case Opcode::IF_ICMPGE: case Opcode::IF_ICMPGT: case Opcode::IF_ICMPLE:
+        ok = pop(INT) && pop(INT) && mergeBranch(pos, static_cast<int16_t>(arg));
+        break;
+    case Opcode::GOTO: ok = mergeBranch(pos, static_cast<int16_t>(arg)); break;
+    case Opcode::TABLESWITCH:
+    case Opcode::LOOKUPSWITCH:
+    {
+        ok = pop(INT) && ((static_cast<Opcode>(op) == Opcode::TABLESWITCH) || checkLookupKeys(pos, arg));
+        std::vector<int32_t> offsets = branchOffsets(pos);
+        for (size_t i = 0; ok && (i < offsets.size()); i++)
+        {
+            ok = mergeBranch(pos, offsets[i]);
+        }
+        break;
+    }
+
+    case Opcode::IRETURN: ok = (stackType(method_->ret_type) == INT) && pop(INT); break;
+    case Opcode::LRETURN: ok = (method_->ret_type == LONG) && pop(LONG); break;
+    case Opcode::FRETURN: ok = (method_->ret_type == FLOAT) && pop(FLOAT); break;
+    case Opcode::DRETURN: ok = (method_->ret_type == DOUBLE) && pop(DOUBLE); break;
+    case Opcode::ARETURN: ok = (method_->ret_type == REF) && pop(REF); break;
+    case Opcode::RETURN: ok = (method_->ret_type == VariableType::VOID); break;
+
+    case Opcode::INVOKESTATIC: ok = verifyInvoke(arg, MethodType::STATIC); break;
+    case Opcode::INVOKENATIVE: ok = verifyInvoke(arg, MethodType::NATIVE); break;
+
+    case Opcode::GETSTATIC: ok = verifyStatic(arg, false); break;
+    case Opcode::PUTSTATIC: ok = verifyStatic(arg, true); break;
+
+    default:
+        pushError("unsupported opcode " + std::to_string(static_cast<uint32_t>(op)), pos);
+        return false;
+    }
+
+    if (!ok && (errors_.size() == errors_num))
+    {
+        pushError("operands do not match opcode " + std::to_string(static_cast<uint32_t>(op)), pos);
+    }
+    return ok;
+}
+
+bool Verifier::mergeBranch(uint32_t pos, int32_t offset)
+{
+    size_t target = (pos + offset - begin_) / INSTRUCTION_SIZE;
+    if (!states_[target])
+    {
+        states_[target] = stack_;
+    }
+    else if (*states_[target] != stack_)
+    {
+        pushError("inconsistent operand stack at branch target", pos);
+        return false;
+    }
+    return true;
+}
+
+bool Verifier::verifyInvoke(uint16_t index, MethodType modifier)
+{
+    const AbstractType* cst = constant(index);
+    if (!cst || (cst->type() != AbstractType::Type::STRING))
+    {
+        return false;
+    }
+
+    PkmMethod* callee = resolveMethod(classes_, *class_name_, static_cast<const StringType*>(cst)->value);
+    if (!callee || (callee->modifier != modifier))
+    {
+        return false;
+    }
+
+    for (auto param = callee->met_params.rbegin(); param != callee->met_params.rend(); ++param)
+    {
+        if (!pop(stackType(*param)))
+        {
+            return false;
+        }
+    }
+
+    return (callee->ret_type == VariableType::VOID) || push(stackType(callee->ret_type));
+}
+
+bool Verifier::verifyStatic(uint16_t index, bool put)
+{
+    const AbstractType* cst = constant(index);
+    if (!cst || (cst->type() != AbstractType::Type::STRING))
+    {
+        return false;
+    }
+
+    PkmField* field = resolveField(classes_, *class_name_, static_cast<const StringType*>(cst)->value);
+    if (!field || (field->modifier != FieldType::STATIC))
+    {
+        return false;
+    }
+
+    return put ? pop(stackType(field->var_type)) : push(stackType(field->var_type));
+}
+
+bool Verifier::pop(VariableType var_type)
+{
+    if (stack_.empty() || (stack_.back() != var_type))
+    {
+        return false;
+    }
+    stack_.pop_back();
+    return true;
+}
+
+bool Verifier::popAny(VariableType* var_type)
+{
+    if (stack_.empty())
+    {
+        return false;
+    }
+    if (var_type)
+    {
+        *var_type = stack_.back();
+    }
+    stack_.pop_back();
+    return true;
+}
+
+bool Verifier::push(VariableType var_type)
+{
+    if (stack_.size() >= method_->max_stack)
+    {
+        pushError("operand stack exceeds max stack " + std::to_string(static_cast<uint32_t>(method_->max_stack)), pos_);
+        return false;
+    }
+    stack_.push_back(var_type);
+    return true;
+}
+
+bool Verifier::load(uint16_t index, VariableType var_type)
+{
+    return local(index, var_type) && push(var_type);
+}
+
+bool Verifier::store(uint16_t index, VariableType var_type)
+{
+    return local(index, var_type) && pop(var_type);
+}
+
+bool Verifier::local(uint16_t index, VariableType var_type)
+{
+    if (index >= locals_.size())
+    {
+        return false;
+    }
+    if (locals_[index] == VariableType::VOID)
+    {
+        locals_[index] = var_type;
+    }
+    return locals_[index] == var_type;
+}
+
+const AbstractType* Verifier::constant(uint16_t index)
+{
+    if (index >= cls_->const_pool.size())
+    {
+        return nullptr;
+    }
+    return cls_->const_pool[index].get();
+}
+
+void Verifier::pushError(const std::string& error, uint32_t pos)
+{
+    errors_.push_back(*class_name_ + "." + *method_name_ + " at " + std::to_string(pos - begin_) + " | error: " + error);
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "Compiler/Compiler.h"
 
+#include <cstdlib>
+#include <new>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #define CHECK_ERROR(cond, message)      \
@@ -10,24 +14,113 @@
         return -1;                      \
     } //
 
+// Counts allocations for --time-report; the default array forms call these.
+void* operator new(size_t size)
+{
+    TimeReport::countAllocation(size);
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
 const char* const LANG_EXTENSION = ".pkm";
 const char* const CODE_EXTENSION = ".klass";
 
 int main(int argc, const char* argv[])
 {
-    Compiler comp;
+    size_t jobs = 1;
+    std::string cache_dir;
+    bool opt_stats = false;
+    bool time_report = false;
+    std::vector<Compiler::Unit> units;
     for (int i = 1; i < argc; i++)
     {
-        std::string filename(argv[i]);
-        std::filesystem::path path(filename);
+        std::string arg(argv[i]);
+        if (arg.starts_with("-j"))
+        {
+            std::string num = (arg.size() > 2) ? arg.substr(2) : ((i + 1 < argc) ? argv[++i] : "");
+            char* end = nullptr;
+            jobs = std::strtoul(num.c_str(), &end, 10);
+            CHECK_ERROR(num.empty() || *end || (jobs == 0), "Wrong number of jobs: " + num);
+            continue;
+        }
+        if (arg == "--opt-stats")
+        {
+            opt_stats = true;
+            continue;
+        }
+        if (arg == "--time-report")
+        {
+            time_report = true;
+            continue;
+        }
+        if (arg.starts_with("--cache-dir"))
+        {
+            cache_dir = (arg.size() > 11) ? arg.substr(12) : ((i + 1 < argc) ? argv[++i] : "");
+            CHECK_ERROR(cache_dir.empty() || ((arg.size() > 11) && (arg[11] != '=')), "Wrong option: " + arg);
+            continue;
+        }
+
+        std::filesystem::path path(arg);
         std::string ext(path.extension());
-        CHECK_ERROR((ext != LANG_EXTENSION), "Wrong extension: " + filename + "\nRequired: " + LANG_EXTENSION);
+        CHECK_ERROR((ext != LANG_EXTENSION), "Wrong extension: " + arg + "\nRequired: " + LANG_EXTENSION);
+        units.emplace_back().input_name = arg;
+    }
 
-        int err = comp.compile(filename, CODE_EXTENSION);
-        CHECK_ERROR((err == Compiler::FILE_NOT_FOUND), "File not found: " + filename);
-        CHECK_ERROR((err == Compiler::FILE_NOT_COMPILED), "File not compiled: " + filename);
-        comp.printErrors(std::cout);
+    std::unique_ptr<CompileCache> cache(cache_dir.empty() ? nullptr : new CompileCache(cache_dir));
+    std::unique_ptr<Peephole::Stats> stats(opt_stats ? new Peephole::Stats : nullptr);
+    Compiler comp(jobs, cache.get(), stats.get(), time_report);
+    comp.compile(&units, CODE_EXTENSION);
+
+    int status = 0;
+    for (const auto& unit : units)
+    {
+        for (const auto& err : unit.errors)
+        {
+            std::cout << err << "\n";
+        }
+        if (unit.err == Compiler::FILE_NOT_FOUND)
+        {
+            std::cout << "File not found: " << unit.input_name << "\n";
+            status = -1;
+        }
+        if (unit.err == Compiler::FILE_NOT_COMPILED)
+        {
+            std::cout << "File not compiled: " << unit.input_name << "\n";
+            status = -1;
+        }
+    }
+
+    if (cache)
+    {
+        std::cout << "Cache: " << cache->hits() << " hits, " << cache->misses() << " misses\n";
+    }
+    if (stats)
+    {
+        stats->print(std::cout);
+    }
+    if (time_report)
+    {
+        std::vector<const TimeReport*> reports;
+        for (const auto& unit : units)
+        {
+            reports.push_back(&unit.report);
+        }
+        TimeReport::print(std::cout, reports);
     }
 
-    return 0;
+    return status;
 }
\ No newline at end of file
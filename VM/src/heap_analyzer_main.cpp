@@ -0,0 +1,41 @@
+#include "VM/Heap/HeapAnalyzer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define CHECK_ERROR(cond, message)      \
+    if (cond) {                         \
+        std::cout << (message) << "\n"; \
+        return -1;                      \
+    } //
+
+// Usage: heap_analyzer [--top=<n>] <snapshot>
+int main(int argc, char* argv[])
+{
+    size_t top = 20;
+    std::string file_name;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        if (arg.starts_with("--top="))
+        {
+            char* end = nullptr;
+            top = std::strtoul(arg.c_str() + 6, &end, 10);
+            CHECK_ERROR(*end, "Wrong option: " + arg);
+            continue;
+        }
+        CHECK_ERROR(!file_name.empty(), "Wrong option: " + arg);
+        file_name = arg;
+    }
+    CHECK_ERROR(file_name.empty(), "Usage: heap_analyzer [--top=<n>] <snapshot>");
+
+    HeapAnalyzer analyzer;
+    int err = analyzer.load(file_name);
+    CHECK_ERROR(err == HeapAnalyzer::FILE_NOT_OPENED, "Snapshot not opened: " + file_name);
+    CHECK_ERROR(err == HeapAnalyzer::WRONG_FORMAT, "Snapshot is corrupted: " + file_name);
+
+    analyzer.analyze();
+    analyzer.print(std::cout, top);
+    return 0;
+}
\ No newline at end of file
@@ -1,10 +1,22 @@
 #include "VM/ClassLinker.h"
+#include "VM/Heap/HeapSnapshot.h"
+#include "VM/Interpreter/AllocationProfiler.h"
+#include "VM/Interpreter/Profiler.h"
 #include "VM/Klass/KlassLoader.h"
+#include "VM/Metrics/Metrics.h"
 #include "VM/PNI.h"
+#include "VM/Trace/Tracer.h"
 
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <pthread.h>
+#include <string>
+#include <thread>
 #include <vector>
 
 #define CHECK_ERROR(cond, message)      \
@@ -17,13 +29,87 @@ const char* const BIN_FOLDER = "./pkm/bin";
 
 int main(int argc, char* argv[])
 {
+    std::string profile_file;
+    std::string trace_file;
+    std::string alloc_file;
+    std::string snapshot_file;
+    size_t alloc_interval = AllocationProfiler::DEFAULT_INTERVAL;
+    bool metrics = false;
+    std::string metrics_name;
+    std::vector<char*> files = {argv[0]};
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        if (arg.starts_with("--profile"))
+        {
+            profile_file = (arg.size() > 9) ? arg.substr(10) : ((i + 1 < argc) ? argv[++i] : "");
+            CHECK_ERROR(profile_file.empty() || ((arg.size() > 9) && (arg[9] != '=')), "Wrong option: " + arg);
+            continue;
+        }
+        if (arg.starts_with("--alloc-profile="))
+        {
+            alloc_file = arg.substr(16);
+            CHECK_ERROR(alloc_file.empty(), "Wrong option: " + arg);
+            continue;
+        }
+        if (arg.starts_with("--alloc-interval="))
+        {
+            char* end = nullptr;
+            alloc_interval = std::strtoul(arg.c_str() + 17, &end, 10);
+            CHECK_ERROR(*end || (alloc_interval == 0), "Wrong option: " + arg);
+            continue;
+        }
+        if (arg.starts_with("--heap-snapshot="))
+        {
+            snapshot_file = arg.substr(16);
+            CHECK_ERROR(snapshot_file.empty(), "Wrong option: " + arg);
+            continue;
+        }
+        if (arg.starts_with("--trace"))
+        {
+            trace_file = (arg.size() > 7) ? arg.substr(8) : ((i + 1 < argc) ? argv[++i] : "");
+            CHECK_ERROR(trace_file.empty() || ((arg.size() > 7) && (arg[7] != '=')), "Wrong option: " + arg);
+            continue;
+        }
+        if ((arg == "--metrics") || arg.starts_with("--metrics="))
+        {
+            metrics = true;
+            metrics_name = (arg.size() > 9) ? arg.substr(10) : "";
+            continue;
+        }
+        files.push_back(argv[i]);
+    }
+
+    // Every thread started from here on inherits the blocked SIGUSR2, so only
+    // the snapshot thread below receives it.
+    sigset_t snapshot_signal;
+    sigemptyset(&snapshot_signal);
+    sigaddset(&snapshot_signal, SIGUSR2);
+    if (!snapshot_file.empty())
+    {
+        pthread_sigmask(SIG_BLOCK, &snapshot_signal, nullptr);
+    }
+
+    // Stopped by the destructor on every return, so failed runs leave a trace too.
+    Tracer tracer;
+    CHECK_ERROR(!trace_file.empty() && tracer.start(trace_file), "Tracer not started: " + trace_file);
+
+    Metrics runtime_metrics;
+    CHECK_ERROR(metrics && runtime_metrics.open(metrics_name), "Metrics segment not created");
+
     KlassLoader kl;
     kl.loadLib(BIN_FOLDER);
-    int err = kl.loadUser(argc, argv);
-    CHECK_ERROR(err, "Klass file not loaded: " + std::string(argv[err]));
+    int err = kl.loadUser(static_cast<int>(files.size()), files.data());
+    CHECK_ERROR(err, "Klass file not loaded: " + std::string(files[err]));
 
     ClassLinker cl;
-    cl.link(kl.klasses);
+    err = cl.link(kl.klasses);
+    if (err)
+    {
+        cl.printErrors(std::cout);
+    }
+    CHECK_ERROR(err == ClassLinker::KLASS_CORRUPTED, "Klass file is corrupted");
+    CHECK_ERROR(err == ClassLinker::CLASS_NOT_VERIFIED, "Class verification failed");
 
     PkmVM* pvm = nullptr;
     PNIEnv* env = nullptr;
@@ -35,9 +121,67 @@ int main(int argc, char* argv[])
     CHECK_ERROR(cls == nullptr, "Class Main not found");
 
     pmethodID mid = PNIEnv::getMethodID(cls, "main");
-    CHECK_ERROR(cls == nullptr, "Method main not found");
+    CHECK_ERROR(mid == nullptr, "Method main not found");
+
+    std::unique_ptr<Profiler> profiler(profile_file.empty() ? nullptr : new Profiler);
+    CHECK_ERROR(profiler && profiler->start(), "Profiler not started");
+
+    std::unique_ptr<AllocationProfiler> alloc_profiler(
+        alloc_file.empty() ? nullptr : new AllocationProfiler(alloc_interval));
+    CHECK_ERROR(alloc_profiler && alloc_profiler->start(), "Allocation profiler not started");
+
+    // Linked classes do not change while main runs, so snapshots need no pause.
+    std::atomic<bool> running = true;
+    std::thread snapshots;
+    if (!snapshot_file.empty())
+    {
+        snapshots = std::thread([&] {
+            int signo = 0;
+            for (size_t n = 1; (sigwait(&snapshot_signal, &signo) == 0) && running; n++)
+            {
+                std::string file = snapshot_file + "." + std::to_string(n);
+                bool written = (env->dumpHeap(file) == HeapSnapshotWriter::OK);
+                std::cout << (written ? "Heap snapshot written: " : "Heap snapshot not written: ") << file << "\n";
+            }
+        });
+    }
+
+    err = PNIEnv::callMethod(cls, mid);
+
+    if (snapshots.joinable())
+    {
+        running = false;
+        pthread_kill(snapshots.native_handle(), SIGUSR2);
+        snapshots.join();
+    }
+
+    if (profiler)
+    {
+        profiler->stop();
+        std::ofstream profile(profile_file);
+        CHECK_ERROR(!profile.is_open(), "Profile not written: " + profile_file);
+        profiler->writeFolded(profile);
+        if (profiler->dropped())
+        {
+            std::cout << "Profiler dropped " << profiler->dropped() << " samples\n";
+        }
+    }
+    if (alloc_profiler)
+    {
+        alloc_profiler->stop();
+        std::ofstream alloc_profile(alloc_file);
+        CHECK_ERROR(!alloc_profile.is_open(), "Allocation profile not written: " + alloc_file);
+        alloc_profiler->writeSummary(alloc_profile);
+    }
+    CHECK_ERROR(err == Interpreter::STACK_OVERFLOW, "Stack overflow");
+    CHECK_ERROR(err == Interpreter::ARITHMETIC_ERROR, "Arithmetic error: division by zero");
+    CHECK_ERROR(err == Interpreter::UNSUPPORTED_OPCODE, "Unsupported opcode");
 
-    PNIEnv::callMethod(cls, mid);
+    tracer.stop();
+    if (tracer.dropped())
+    {
+        std::cout << "Tracer dropped " << tracer.dropped() << " events\n";
+    }
 
     PkmVM::destroyVM();
     delete pvm;
@@ -0,0 +1,52 @@
+#include "VM/Metrics/Metrics.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#define CHECK_ERROR(cond, message)      \
+    if (cond) {                         \
+        std::cout << (message) << "\n"; \
+        return -1;                      \
+    } //
+
+// Usage: vm_metrics [--watch=<ms>] <pid | /segment-name>
+int main(int argc, char* argv[])
+{
+    long watch_ms = 0;
+    std::string name;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        if (arg.starts_with("--watch="))
+        {
+            char* end = nullptr;
+            watch_ms = std::strtol(arg.c_str() + 8, &end, 10);
+            CHECK_ERROR(*end || (watch_ms <= 0), "Wrong option: " + arg);
+            continue;
+        }
+        CHECK_ERROR(!name.empty(), "Wrong option: " + arg);
+        name = arg.starts_with("/") ? arg : Metrics::defaultName(static_cast<pid_t>(std::atol(arg.c_str())));
+    }
+    CHECK_ERROR(name.empty(), "Usage: vm_metrics [--watch=<ms>] <pid | /segment-name>");
+
+    MetricsReader reader;
+    int err = reader.open(name);
+    CHECK_ERROR(err == Metrics::SEGMENT_NOT_OPENED, "Metrics segment not found: " + name);
+    CHECK_ERROR(err == Metrics::WRONG_SEGMENT, "Metrics segment has an unknown layout: " + name);
+
+    // A segment stays mapped after its VM exits, so watching stops with the VM.
+    reader.print(std::cout);
+    auto pid = static_cast<pid_t>(reader.segment()->pid);
+    while (watch_ms && (kill(pid, 0) == 0))
+    {
+        std::cout << std::endl;
+        std::this_thread::sleep_for(std::chrono::milliseconds(watch_ms));
+        reader.print(std::cout);
+    }
+
+    return 0;
+}
\ No newline at end of file
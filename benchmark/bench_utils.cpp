@@ -0,0 +1,129 @@
+#include "bench_utils.h"
+#include "Compiler/AST/ASTMaker.h"
+#include "Compiler/Optimizer/ASTOptimizer.h"
+#include "Compiler/Optimizer/Inliner.h"
+#include "Compiler/Source/SourceFile.h"
+#include "Compiler/Translator/Translator.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+std::string benchDir()
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "vm_benchmark";
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+std::string writeFile(const std::string& name, const std::string& content)
+{
+    std::string path = benchDir() + "/" + name;
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+    return path;
+}
+
+std::string generateSource(const std::string& class_name, size_t methods)
+{
+    std::stringstream ss;
+    ss << "class " << class_name << " {\n";
+    ss << "    public static int counter;\n";
+    for (size_t i = 0; i < methods; i++)
+    {
+        ss << "    public static int m" << i << "(int a, int b) {\n";
+        ss << "        int s = 0;\n";
+        ss << "        while (a < b) {\n";
+        ss << "            if (a < " << i << ") {\n";
+        ss << "                s = s + a * 3;\n";
+        ss << "            } elif (a == " << i + 1 << ") {\n";
+        ss << "                s = s - counter;\n";
+        ss << "            } else {\n";
+        ss << "                s = s - b / 2;\n";
+        ss << "            }\n";
+        ss << "            a = a + 1;\n";
+        ss << "        }\n";
+        if (i > 0)
+        {
+            ss << "        s = s + m" << i - 1 << "(s, b);\n";
+        }
+        ss << "        return s;\n";
+        ss << "    }\n";
+    }
+    ss << "}\n";
+    return ss.str();
+}
+
+bool makeAST(const std::string& path, AST* ast)
+{
+    SourceFile source(path);
+    ASTMaker ast_maker(&source);
+    ast_maker.make(ast);
+    return source.is_open() && !ast_maker.err() && (ast->branches_num() != 0);
+}
+
+std::string translate(AST* ast, size_t class_num)
+{
+    std::string path = benchDir() + "/translate.klass";
+    std::ofstream file(path, std::ios::binary);
+    Translator trans(ast, class_num);
+    trans.translate(&file);
+    file.close();
+
+    std::ifstream klass(path, std::ios::binary);
+    std::stringstream ss;
+    ss << klass.rdbuf();
+    return ss.str();
+}
+
+std::string compileFile(const std::string& path)
+{
+    AST ast;
+    if (!makeAST(path, &ast))
+    {
+        return {};
+    }
+    Inliner inliner(&ast);
+    inliner.inlineCalls();
+    ASTOptimizer optimizer(&ast);
+    optimizer.optimize();
+    return translate(&ast);
+}
+
+Workload* loadWorkload(const std::string& file, const std::string& class_name)
+{
+    // A null entry caches a failed load, so later Args skip without retrying.
+    static std::map<std::string, std::unique_ptr<Workload>> workloads;
+    auto [it, inserted] = workloads.try_emplace(file);
+    if (!inserted)
+    {
+        return it->second.get();
+    }
+
+    auto workload = std::make_unique<Workload>();
+    std::string klass = compileFile(std::string(WORKLOADS_DIR) + "/" + file + ".pkm");
+    if (klass.empty() || workload->linker.link({klass}))
+    {
+        workload->linker.printErrors(std::cerr);
+        return nullptr;
+    }
+
+    auto cls = workload->linker.classes.find(class_name);
+    if (cls == workload->linker.classes.end())
+    {
+        std::cerr << file << ": no class " << class_name << "\n";
+        return nullptr;
+    }
+    auto run = cls->second.methods.find("run");
+    if (run == cls->second.methods.end())
+    {
+        std::cerr << file << ": no method " << class_name << ".run\n";
+        return nullptr;
+    }
+    workload->run = &run->second;
+    it->second = std::move(workload);
+    return it->second.get();
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef BENCHMARK_BENCH_UTILS_H
+#define BENCHMARK_BENCH_UTILS_H
+
+#include "Compiler/AST/AST.h"
+#include "VM/ClassLinker.h"
+
+#include <string>
+
+// Scratch directory for generated sources and klass files.
+std::string benchDir();
+std::string writeFile(const std::string& name, const std::string& content);
+
+// A class of `methods` static methods with loops, branches and calls, so
+// every compile and link stage grows linearly with the argument.
+std::string generateSource(const std::string& class_name, size_t methods);
+
+bool makeAST(const std::string& path, AST* ast);
+std::string translate(AST* ast, size_t class_num = 0);
+
+// Runs the same pipeline as Compiler, but keeps the klass in memory.
+std::string compileFile(const std::string& path);
+
+struct Workload
+{
+    ClassLinker linker;
+    PkmMethod* run = nullptr;
+};
+
+// Compiles and links benchmark/workloads/<file>.pkm once per process.
+Workload* loadWorkload(const std::string& file, const std::string& class_name);
+
+#endif // BENCHMARK_BENCH_UTILS_H
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "Comparison.h"
+#include "Json.h"
+
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+static double timeUnit(const JsonValue* unit)
+{
+    if (!unit || (unit->string == "ns"))
+    {
+        return 1;
+    }
+    if (unit->string == "us")
+    {
+        return 1e3;
+    }
+    if (unit->string == "ms")
+    {
+        return 1e6;
+    }
+    return 1e9;
+}
+
+int Report::load(const std::string& file_name, bool cpu_time)
+{
+    std::ifstream file(file_name);
+    if (!file.is_open())
+    {
+        return FILE_NOT_FOUND;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string text = ss.str();
+
+    JsonValue report;
+    JsonParser parser(text);
+    const JsonValue* benchmarks = parser.parse(&report) ? report.find("benchmarks") : nullptr;
+    if (!benchmarks || (benchmarks->type != JsonValue::Type::ARRAY))
+    {
+        return FILE_CORRUPTED;
+    }
+
+    for (const auto& entry : benchmarks->array)
+    {
+        const JsonValue* run_type = entry.find("run_type");
+        if (run_type && (run_type->string != "iteration"))
+        {
+            continue;
+        }
+        if (entry.find("error_occurred"))
+        {
+            continue;
+        }
+
+        const JsonValue* name = entry.find("run_name");
+        name = name ? name : entry.find("name");
+        const JsonValue* time = entry.find(cpu_time ? "cpu_time" : "real_time");
+        if (!name || !time || (time->type != JsonValue::Type::NUMBER))
+        {
+            return FILE_CORRUPTED;
+        }
+        results[name->string].push_back(time->number * timeUnit(entry.find("time_unit")));
+    }
+
+    return OK;
+}
+
+static double mean(const std::vector<double>& values)
+{
+    return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+}
+
+static double variance(const std::vector<double>& values, double avg)
+{
+    if (values.size() < 2)
+    {
+        return 0;
+    }
+    double sum = 0;
+    for (double value : values)
+    {
+        sum += (value - avg) * (value - avg);
+    }
+    return sum / static_cast<double>(values.size() - 1);
+}
+
+Comparison compare(const std::string& name, const std::vector<double>& base, const std::vector<double>& current,
+    double confidence)
+{
+    Comparison cmp = {name, base.size(), current.size(), mean(base), mean(current), 0, 0, 0};
+
+    double base_var = variance(base, cmp.base_mean) / static_cast<double>(base.size());
+    double current_var = variance(current, cmp.current_mean) / static_cast<double>(current.size());
+    double se = std::sqrt(base_var + current_var);
+
+    double margin = 0;
+    if (se > 0)
+    {
+        // Welch-Satterthwaite degrees of freedom; a side without variance
+        // adds nothing to the denominator.
+        double den = 0;
+        den += (base.size() > 1) ? base_var * base_var / static_cast<double>(base.size() - 1) : 0;
+        den += (current.size() > 1) ? current_var * current_var / static_cast<double>(current.size() - 1) : 0;
+        double df = (base_var + current_var) * (base_var + current_var) / den;
+        margin = studentQuantile(0.5 + confidence / 2, df) * se;
+    }
+
+    double diff = cmp.current_mean - cmp.base_mean;
+    cmp.delta = diff / cmp.base_mean;
+    cmp.low = (diff - margin) / cmp.base_mean;
+    cmp.high = (diff + margin) / cmp.base_mean;
+    return cmp;
+}
+
+// Continued fraction of the regularized incomplete beta function.
+static double betaFraction(double a, double b, double x)
+{
+    const double tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    d = 1 / ((std::fabs(d) < tiny) ? tiny : d);
+    double h = d;
+    for (int m = 1; m <= 300; m++)
+    {
+        double m2 = 2 * m;
+        double steps[2] = {m * (b - m) * x / ((a + m2 - 1) * (a + m2)),
+            -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1))};
+        for (double step : steps)
+        {
+            d = 1 + step * d;
+            d = 1 / ((std::fabs(d) < tiny) ? tiny : d);
+            c = 1 + step / c;
+            c = (std::fabs(c) < tiny) ? tiny : c;
+            h *= d * c;
+        }
+        if (std::fabs(d * c - 1) < 1e-12)
+        {
+            break;
+        }
+    }
+    return h;
+}
+
+static double incompleteBeta(double a, double b, double x)
+{
+    if ((x <= 0) || (x >= 1))
+    {
+        return (x <= 0) ? 0 : 1;
+    }
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) +
+        b * std::log(1 - x));
+    if (x < (a + 1) / (a + b + 2))
+    {
+        return front * betaFraction(a, b, x) / a;
+    }
+    return 1 - front * betaFraction(b, a, 1 - x) / b;
+}
+
+static double studentCDF(double t, double df)
+{
+    double tail = incompleteBeta(df / 2, 0.5, df / (df + t * t)) / 2;
+    return (t > 0) ? 1 - tail : tail;
+}
+
+double studentQuantile(double p, double df)
+{
+    double low = 0;
+    double high = 1e3;
+    for (int i = 0; i < 200; i++)
+    {
+        double mid = (low + high) / 2;
+        if (studentCDF(mid, df) < p)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return (low + high) / 2;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BENCHMARK_COMPARE_COMPARISON_H
+#define BENCHMARK_COMPARE_COMPARISON_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Per-repetition times in nanoseconds, keyed by benchmark run name.
+using Results = std::map<std::string, std::vector<double>>;
+
+// Reads the "iteration" entries of a Google Benchmark JSON report; the
+// aggregates it may contain are recomputed here from the repetitions.
+class Report
+{
+public:
+    enum Errors
+    {
+        OK,
+        FILE_NOT_FOUND,
+        FILE_CORRUPTED,
+    };
+
+    Report() = default;
+    int load(const std::string& file_name, bool cpu_time);
+
+    Results results;
+};
+
+struct Comparison
+{
+    std::string name;
+    size_t base_runs;
+    size_t current_runs;
+    double base_mean;
+    double current_mean;
+    // Relative change of the mean and its confidence interval.
+    double delta;
+    double low;
+    double high;
+};
+
+// Welch's t interval for the difference of the means, scaled by the
+// baseline mean. A single run on either side contributes no variance.
+Comparison compare(const std::string& name, const std::vector<double>& base, const std::vector<double>& current,
+    double confidence);
+
+double studentQuantile(double p, double df);
+
+#endif // BENCHMARK_COMPARE_COMPARISON_H
\ No newline at end of file
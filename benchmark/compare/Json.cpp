@@ -0,0 +1,217 @@
+#include "Json.h"
+
+#include <cstdlib>
+#include <cstring>
+
+const JsonValue* JsonValue::find(const std::string& key) const
+{
+    for (const auto& [name, value] : object)
+    {
+        if (name == key)
+        {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+JsonParser::JsonParser(const std::string& text) : text_(text) {}
+
+bool JsonParser::parse(JsonValue* value)
+{
+    if (!parseValue(value))
+    {
+        return false;
+    }
+    skipSpaces();
+    return pos_ == text_.size();
+}
+
+size_t JsonParser::errorPos() const
+{
+    return pos_;
+}
+
+bool JsonParser::parseValue(JsonValue* value)
+{
+    skipSpaces();
+    if (pos_ >= text_.size())
+    {
+        return false;
+    }
+
+    switch (text_[pos_])
+    {
+    case '{':
+        value->type = JsonValue::Type::OBJECT;
+        pos_++;
+        skipSpaces();
+        if ((pos_ < text_.size()) && (text_[pos_] == '}'))
+        {
+            pos_++;
+            return true;
+        }
+        while (true)
+        {
+            std::string key;
+            skipSpaces();
+            if (!parseString(&key))
+            {
+                return false;
+            }
+            skipSpaces();
+            if ((pos_ >= text_.size()) || (text_[pos_++] != ':'))
+            {
+                return false;
+            }
+            value->object.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(&value->object.back().second))
+            {
+                return false;
+            }
+            skipSpaces();
+            if ((pos_ < text_.size()) && (text_[pos_] == ','))
+            {
+                pos_++;
+                continue;
+            }
+            return (pos_ < text_.size()) && (text_[pos_++] == '}');
+        }
+    case '[':
+        value->type = JsonValue::Type::ARRAY;
+        pos_++;
+        skipSpaces();
+        if ((pos_ < text_.size()) && (text_[pos_] == ']'))
+        {
+            pos_++;
+            return true;
+        }
+        while (true)
+        {
+            value->array.emplace_back();
+            if (!parseValue(&value->array.back()))
+            {
+                return false;
+            }
+            skipSpaces();
+            if ((pos_ < text_.size()) && (text_[pos_] == ','))
+            {
+                pos_++;
+                continue;
+            }
+            return (pos_ < text_.size()) && (text_[pos_++] == ']');
+        }
+    case '"':
+        value->type = JsonValue::Type::STRING;
+        return parseString(&value->string);
+    case 't':
+        value->type = JsonValue::Type::BOOLEAN;
+        value->boolean = true;
+        return parseLiteral("true");
+    case 'f':
+        value->type = JsonValue::Type::BOOLEAN;
+        return parseLiteral("false");
+    case 'n':
+        return parseLiteral("null");
+    default:
+        value->type = JsonValue::Type::NUMBER;
+        return parseNumber(&value->number);
+    }
+}
+
+// Benchmark names are ASCII, so \u escapes are kept only for code points
+// below 0x80 and replaced with '?' otherwise.
+bool JsonParser::parseString(std::string* str)
+{
+    if ((pos_ >= text_.size()) || (text_[pos_] != '"'))
+    {
+        return false;
+    }
+    pos_++;
+
+    while (pos_ < text_.size())
+    {
+        char ch = text_[pos_++];
+        if (ch == '"')
+        {
+            return true;
+        }
+        if (ch != '\\')
+        {
+            str->push_back(ch);
+            continue;
+        }
+        if (pos_ >= text_.size())
+        {
+            return false;
+        }
+
+        ch = text_[pos_++];
+        switch (ch)
+        {
+        case 'b':
+            str->push_back('\b');
+            break;
+        case 'f':
+            str->push_back('\f');
+            break;
+        case 'n':
+            str->push_back('\n');
+            break;
+        case 'r':
+            str->push_back('\r');
+            break;
+        case 't':
+            str->push_back('\t');
+            break;
+        case 'u':
+        {
+            if (pos_ + 4 > text_.size())
+            {
+                return false;
+            }
+            long code = std::strtol(text_.substr(pos_, 4).c_str(), nullptr, 16);
+            str->push_back((code < 0x80) ? static_cast<char>(code) : '?');
+            pos_ += 4;
+            break;
+        }
+        default:
+            str->push_back(ch);
+            break;
+        }
+    }
+    return false;
+}
+
+bool JsonParser::parseNumber(double* number)
+{
+    const char* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    *number = std::strtod(begin, &end);
+    if (end == begin)
+    {
+        return false;
+    }
+    pos_ += static_cast<size_t>(end - begin);
+    return true;
+}
+
+bool JsonParser::parseLiteral(const char* literal)
+{
+    size_t len = std::strlen(literal);
+    if (text_.compare(pos_, len, literal) != 0)
+    {
+        return false;
+    }
+    pos_ += len;
+    return true;
+}
+
+void JsonParser::skipSpaces()
+{
+    while ((pos_ < text_.size()) &&
+           ((text_[pos_] == ' ') || (text_[pos_] == '\t') || (text_[pos_] == '\r') || (text_[pos_] == '\n')))
+    {
+        pos_++;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef BENCHMARK_COMPARE_JSON_H
+#define BENCHMARK_COMPARE_JSON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Just enough JSON to read Google Benchmark reports.
+struct JsonValue
+{
+    enum class Type
+    {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT,
+    };
+
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue* find(const std::string& key) const;
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(const std::string& text);
+
+    bool parse(JsonValue* value);
+    size_t errorPos() const;
+
+private:
+    bool parseValue(JsonValue* value);
+    bool parseString(std::string* str);
+    bool parseNumber(double* number);
+    bool parseLiteral(const char* literal);
+    void skipSpaces();
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+#endif // BENCHMARK_COMPARE_JSON_H
\ No newline at end of file
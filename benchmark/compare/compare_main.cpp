@@ -0,0 +1,110 @@
+#include "Comparison.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#define CHECK_ERROR(cond, message)      \
+    if (cond) {                         \
+        std::cout << (message) << "\n"; \
+        return -1;                      \
+    } //
+
+static bool parseNumber(const std::string& arg, size_t prefix, double* number)
+{
+    char* end = nullptr;
+    *number = std::strtod(arg.c_str() + prefix, &end);
+    return (arg.size() > prefix) && !*end;
+}
+
+static std::string percent(double value)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%+.2f%%", value * 100);
+    return buf;
+}
+
+int main(int argc, const char* argv[])
+{
+    double threshold = 5;
+    double confidence = 0.95;
+    bool cpu_time = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        if (arg.starts_with("--threshold="))
+        {
+            CHECK_ERROR(!parseNumber(arg, 12, &threshold) || (threshold < 0), "Wrong threshold: " + arg);
+            continue;
+        }
+        if (arg.starts_with("--confidence="))
+        {
+            CHECK_ERROR(!parseNumber(arg, 13, &confidence) || (confidence <= 0) || (confidence >= 1),
+                "Wrong confidence: " + arg);
+            continue;
+        }
+        if (arg == "--cpu-time")
+        {
+            cpu_time = true;
+            continue;
+        }
+        CHECK_ERROR(arg.starts_with("--"), "Wrong option: " + arg);
+        files.push_back(arg);
+    }
+    CHECK_ERROR(files.size() != 2, "Usage: vm_benchmark_compare [--threshold=<percent>] [--confidence=<level>] "
+        "[--cpu-time] <baseline.json> <current.json>");
+
+    Report base;
+    Report current;
+    for (auto [report, file] : {std::pair(&base, files[0]), std::pair(&current, files[1])})
+    {
+        int err = report->load(file, cpu_time);
+        CHECK_ERROR(err == Report::FILE_NOT_FOUND, "File not found: " + file);
+        CHECK_ERROR(err == Report::FILE_CORRUPTED, "Not a benchmark report: " + file);
+    }
+
+    size_t regressions = 0;
+    std::printf("%-40s %5s %14s %14s %10s %24s\n", "Benchmark", "Runs", "Baseline ns", "Current ns", "Delta",
+        "Confidence interval");
+    for (const auto& [name, times] : current.results)
+    {
+        if (!base.results.contains(name))
+        {
+            std::printf("%-40s new\n", name.c_str());
+            continue;
+        }
+
+        Comparison cmp = compare(name, base.results[name], times, confidence);
+        const char* verdict = "";
+        if (cmp.low * 100 > threshold)
+        {
+            verdict = "REGRESSION";
+            regressions++;
+        }
+        else if (cmp.high * 100 < -threshold)
+        {
+            verdict = "improvement";
+        }
+        std::string interval = "[" + percent(cmp.low) + ", " + percent(cmp.high) + "]";
+        std::printf("%-40s %2zu/%-2zu %14.1f %14.1f %10s %24s %s\n", name.c_str(), cmp.base_runs, cmp.current_runs,
+            cmp.base_mean, cmp.current_mean, percent(cmp.delta).c_str(), interval.c_str(), verdict);
+    }
+    for (const auto& [name, times] : base.results)
+    {
+        if (!current.results.contains(name))
+        {
+            std::printf("%-40s missing\n", name.c_str());
+        }
+    }
+
+    // Only changes whose whole interval lies beyond the threshold count, so
+    // noise on a busy machine does not fail the run.
+    if (regressions)
+    {
+        std::cout << regressions << " benchmark(s) regressed by more than " << threshold << "%\n";
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
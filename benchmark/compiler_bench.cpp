@@ -0,0 +1,50 @@
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_ASTMake(benchmark::State& state)
+{
+    auto methods = static_cast<size_t>(state.range(0));
+    std::string source = generateSource("Gen", methods);
+    std::string path = writeFile("Gen.pkm", source);
+    for (auto _ : state)
+    {
+        AST ast;
+        if (!makeAST(path, &ast))
+        {
+            state.SkipWithError("source not parsed");
+            break;
+        }
+        benchmark::DoNotOptimize(ast.branches_num());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ASTMake)->RangeMultiplier(4)->Range(4, 1024)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_Translate(benchmark::State& state)
+{
+    AST ast;
+    if (!makeAST(writeFile("Gen.pkm", generateSource("Gen", static_cast<size_t>(state.range(0)))), &ast))
+    {
+        state.SkipWithError("source not parsed");
+        return;
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(translate(&ast));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Translate)->RangeMultiplier(4)->Range(4, 1024)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_Compile(benchmark::State& state)
+{
+    std::string path = writeFile("Gen.pkm", generateSource("Gen", static_cast<size_t>(state.range(0))));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(compileFile(path));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Compile)->RangeMultiplier(4)->Range(4, 1024)->Complexity()->Unit(benchmark::kMicrosecond);
\ No newline at end of file
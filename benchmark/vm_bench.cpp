@@ -0,0 +1,97 @@
+#include "bench_utils.h"
+#include "VM/PNIEnv.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+static const size_t METHODS_PER_CLASS = 16;
+
+// Writes `classes` klass files into their own folder, as pkm/bin would hold.
+static std::string makeLib(size_t classes, Klasses* klasses = nullptr)
+{
+    std::string folder = benchDir() + "/lib" + std::to_string(classes);
+    std::filesystem::create_directories(folder);
+    for (size_t i = 0; i < classes; i++)
+    {
+        std::string name = "Gen" + std::to_string(i);
+        AST ast;
+        makeAST(writeFile(name + ".pkm", generateSource(name, METHODS_PER_CLASS)), &ast);
+        std::string klass = translate(&ast);
+        writeFile("lib" + std::to_string(classes) + "/" + name + ".klass", klass);
+        if (klasses)
+        {
+            klasses->push_back(std::move(klass));
+        }
+    }
+    return folder;
+}
+
+static void BM_LoadLib(benchmark::State& state)
+{
+    std::string folder = makeLib(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        KlassLoader kl;
+        kl.loadLib(folder.c_str());
+        benchmark::DoNotOptimize(kl.klasses.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LoadLib)->RangeMultiplier(4)->Range(1, 256)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_Link(benchmark::State& state)
+{
+    Klasses klasses;
+    makeLib(static_cast<size_t>(state.range(0)), &klasses);
+    for (auto _ : state)
+    {
+        ClassLinker cl;
+        if (cl.link(klasses))
+        {
+            state.SkipWithError("classes not linked");
+            break;
+        }
+        benchmark::DoNotOptimize(cl.classes.size());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Link)->RangeMultiplier(4)->Range(1, 256)->Complexity()->Unit(benchmark::kMicrosecond);
+
+static void BM_FindMethod(benchmark::State& state)
+{
+    auto classes = static_cast<size_t>(state.range(0));
+    Klasses klasses;
+    makeLib(classes, &klasses);
+    ClassLinker cl;
+    cl.link(klasses);
+
+    PkmVM vm;
+    PNIEnv env(&vm);
+    env.loadClasses(&cl.classes);
+
+    std::vector<std::string> class_names;
+    std::vector<std::string> method_names;
+    for (size_t i = 0; i < classes; i++)
+    {
+        class_names.push_back("Gen" + std::to_string(i));
+    }
+    for (size_t i = 0; i < METHODS_PER_CLASS; i++)
+    {
+        method_names.push_back("m" + std::to_string(i));
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& class_name : class_names)
+        {
+            pclass cls = env.findClass(class_name);
+            for (const auto& method_name : method_names)
+            {
+                benchmark::DoNotOptimize(PNIEnv::getMethodID(cls, method_name));
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * classes * METHODS_PER_CLASS));
+}
+BENCHMARK(BM_FindMethod)->RangeMultiplier(4)->Range(1, 256);
\ No newline at end of file
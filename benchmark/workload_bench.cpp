@@ -0,0 +1,56 @@
+#include "bench_utils.h"
+#include "VM/Interpreter/Interpreter.h"
+
+#include <benchmark/benchmark.h>
+
+static void runWorkload(benchmark::State& state, const std::string& file, const std::string& class_name)
+{
+    Workload* workload = loadWorkload(file, class_name);
+    if (!workload)
+    {
+        state.SkipWithError("workload not compiled");
+        return;
+    }
+
+    std::vector<PkmValue> args = {PkmValue {.i = static_cast<int32_t>(state.range(0))}};
+    PkmValue result = {};
+    for (auto _ : state)
+    {
+        if (Interpreter::execute(workload->run, args, &result) != Interpreter::OK)
+        {
+            state.SkipWithError("workload failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void BM_Fib(benchmark::State& state)
+{
+    runWorkload(state, "fib", "Fib");
+}
+BENCHMARK(BM_Fib)->Arg(15)->Arg(20)->Arg(25)->Unit(benchmark::kMillisecond);
+
+static void BM_NBody(benchmark::State& state)
+{
+    runWorkload(state, "nbody", "NBody");
+}
+BENCHMARK(BM_NBody)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_BinaryTrees(benchmark::State& state)
+{
+    runWorkload(state, "binary_trees", "BinaryTrees");
+}
+BENCHMARK(BM_BinaryTrees)->Arg(10)->Arg(14)->Unit(benchmark::kMillisecond);
+
+static void BM_SpectralNorm(benchmark::State& state)
+{
+    runWorkload(state, "spectral_norm", "SpectralNorm");
+}
+BENCHMARK(BM_SpectralNorm)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_StringBuild(benchmark::State& state)
+{
+    runWorkload(state, "string_build", "StringBuild");
+}
+BENCHMARK(BM_StringBuild)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
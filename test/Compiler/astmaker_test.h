@@ -10,8 +10,8 @@
     std::ofstream ofile("file"); \
     ofile << (str);              \
     ofile.close();               \
-    std::ifstream ifile("file"); \
-    ASTMaker ast_maker(&ifile);  \
+    SourceFile source("file");   \
+    ASTMaker ast_maker(&source); \
     AST ast;                     \
     ast_maker.make(&ast); //
 
@@ -22,7 +22,7 @@ TEST(ASTMakerTest, Empty) // NOLINT
     )
 
     EXPECT_TRUE(ast.branches_num() == 0);
-    EXPECT_TRUE(ast.value().get()->type() == NodeType::ROOT);
+    EXPECT_TRUE(ast.value()->type() == NodeType::ROOT);
 }
 
 TEST(ASTMakerTest, EmptyClass) // NOLINT
@@ -32,10 +32,10 @@ TEST(ASTMakerTest, EmptyClass) // NOLINT
     )
 
     EXPECT_TRUE(ast.branches_num() == 1);
-    EXPECT_TRUE(ast.value().get()->type() == NodeType::ROOT);
-    EXPECT_TRUE(ast[0].value().get()->type() == NodeType::CLASS);
+    EXPECT_TRUE(ast.value()->type() == NodeType::ROOT);
+    EXPECT_TRUE(ast[0].value()->type() == NodeType::CLASS);
     EXPECT_TRUE(ast[0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<ClassNode*>(ast[0].value().get())->name == "Main");
+    EXPECT_TRUE(static_cast<ClassNode*>(ast[0].value())->name == "Main");
 }
 
 TEST(ASTMakerTest, ClassScope) // NOLINT
@@ -45,10 +45,10 @@ TEST(ASTMakerTest, ClassScope) // NOLINT
     )
 
     EXPECT_TRUE(ast.branches_num() == 1);
-    EXPECT_TRUE(ast.value().get()->type() == NodeType::ROOT);
-    EXPECT_TRUE(ast[0].value().get()->type() == NodeType::CLASS);
+    EXPECT_TRUE(ast.value()->type() == NodeType::ROOT);
+    EXPECT_TRUE(ast[0].value()->type() == NodeType::CLASS);
     EXPECT_TRUE(ast[0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<ClassNode*>(ast[0].value().get())->name == "Main");
+    EXPECT_TRUE(static_cast<ClassNode*>(ast[0].value())->name == "Main");
 }
 
 TEST(ASTMakerTest, ClassOneField) // NOLINT
@@ -59,11 +59,11 @@ TEST(ASTMakerTest, ClassOneField) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][0].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->var_type == VariableType::INT);
 }
 
 TEST(ASTMakerTest, ClassManyFields) // NOLINT
@@ -78,29 +78,29 @@ TEST(ASTMakerTest, ClassManyFields) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][0].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->var_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][1].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][1].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][1].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->name == "b");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->name == "b");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->var_type == VariableType::FLOAT);
 
-    EXPECT_TRUE(ast[0][2].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][2].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][2].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value().get())->name == "_c");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value().get())->access_type == AccessType::PRIVATE);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value().get())->var_type == VariableType::BYTE);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value())->name == "_c");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value())->access_type == AccessType::PRIVATE);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][2].value())->var_type == VariableType::BYTE);
 
-    EXPECT_TRUE(ast[0][3].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][3].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][3].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value().get())->name == "d");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value().get())->access_type == AccessType::PRIVATE);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value())->name == "d");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value())->access_type == AccessType::PRIVATE);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][3].value())->var_type == VariableType::FLOAT);
 }
 
 TEST(ASTMakerTest, ClassOneMethod) // NOLINT
@@ -111,24 +111,24 @@ TEST(ASTMakerTest, ClassOneMethod) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0].value().get()->type() == NodeType::METHOD);
+    EXPECT_TRUE(ast[0][0].value()->type() == NodeType::METHOD);
     EXPECT_TRUE(ast[0][0].branches_num() == 3);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->name == "do_some");
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->modifier == MethodType::STATIC);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->ret_type == VariableType::VOID);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->name == "do_some");
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->modifier == MethodType::STATIC);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->ret_type == VariableType::VOID);
 
-    EXPECT_TRUE(ast[0][0][0].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][0][0].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][0][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value())->var_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][0][1].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][0][1].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][0][1].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value().get())->name == "b");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value())->name == "b");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value())->var_type == VariableType::FLOAT);
 
-    EXPECT_TRUE(ast[0][0][2].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][0][2].value()->type() == NodeType::SCOPE);
     EXPECT_TRUE(ast[0][0][2].branches_num() == 0);
 }
 
@@ -141,39 +141,39 @@ TEST(ASTMakerTest, ClassManyMethods) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0].value().get()->type() == NodeType::METHOD);
+    EXPECT_TRUE(ast[0][0].value()->type() == NodeType::METHOD);
     EXPECT_TRUE(ast[0][0].branches_num() == 3);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->name == "sum");
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->access_type == AccessType::PRIVATE);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->modifier == MethodType::STATIC);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value().get())->ret_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->name == "sum");
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->access_type == AccessType::PRIVATE);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->modifier == MethodType::STATIC);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][0].value())->ret_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][0][0].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][0][0].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][0][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][0].value())->var_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][0][1].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][0][1].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][0][1].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value().get())->name == "b");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value())->name == "b");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][0][1].value())->var_type == VariableType::FLOAT);
 
-    EXPECT_TRUE(ast[0][0][2].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][0][2].value()->type() == NodeType::SCOPE);
     EXPECT_TRUE(ast[0][0][2].branches_num() == 0);
 
-    EXPECT_TRUE(ast[0][1].value().get()->type() == NodeType::METHOD);
+    EXPECT_TRUE(ast[0][1].value()->type() == NodeType::METHOD);
     EXPECT_TRUE(ast[0][1].branches_num() == 2);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value().get())->name == "print");
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value().get())->modifier == MethodType::NATIVE);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value().get())->ret_type == VariableType::VOID);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value())->name == "print");
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value())->modifier == MethodType::NATIVE);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][1].value())->ret_type == VariableType::VOID);
 
-    EXPECT_TRUE(ast[0][1][0].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][1][0].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][1][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][1][0].value().get())->name == "c");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][1][0].value().get())->var_type == VariableType::LONG);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][1][0].value())->name == "c");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][1][0].value())->var_type == VariableType::LONG);
 
-    EXPECT_TRUE(ast[0][1][1].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][1][1].value()->type() == NodeType::SCOPE);
     EXPECT_TRUE(ast[0][1][1].branches_num() == 0);
 }
 
@@ -188,51 +188,51 @@ TEST(ASTMakerTest, ClassManyFieldsMethods) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][0].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][0].value())->var_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][1].value().get()->type() == NodeType::FIELD);
+    EXPECT_TRUE(ast[0][1].value()->type() == NodeType::FIELD);
     EXPECT_TRUE(ast[0][1].branches_num() == 0);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->name == "b");
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->name == "b");
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<FieldNode*>(ast[0][1].value())->var_type == VariableType::FLOAT);
 
-    EXPECT_TRUE(ast[0][2].value().get()->type() == NodeType::METHOD);
+    EXPECT_TRUE(ast[0][2].value()->type() == NodeType::METHOD);
     EXPECT_TRUE(ast[0][2].branches_num() == 3);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value().get())->name == "sum");
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value().get())->access_type == AccessType::PRIVATE);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value().get())->modifier == MethodType::INSTANCE);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value().get())->ret_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value())->name == "sum");
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value())->access_type == AccessType::PRIVATE);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value())->modifier == MethodType::INSTANCE);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][2].value())->ret_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][2][0].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][2][0].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][2][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][0].value().get())->name == "a");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][0].value().get())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][0].value())->name == "a");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][0].value())->var_type == VariableType::INT);
 
-    EXPECT_TRUE(ast[0][2][1].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][2][1].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][2][1].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][1].value().get())->name == "b");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][1].value().get())->var_type == VariableType::FLOAT);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][1].value())->name == "b");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][2][1].value())->var_type == VariableType::FLOAT);
 
-    EXPECT_TRUE(ast[0][2][2].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][2][2].value()->type() == NodeType::SCOPE);
     EXPECT_TRUE(ast[0][2][2].branches_num() == 0);
 
-    EXPECT_TRUE(ast[0][3].value().get()->type() == NodeType::METHOD);
+    EXPECT_TRUE(ast[0][3].value()->type() == NodeType::METHOD);
     EXPECT_TRUE(ast[0][3].branches_num() == 2);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value().get())->name == "print");
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value().get())->access_type == AccessType::PUBLIC);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value().get())->modifier == MethodType::NATIVE);
-    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value().get())->ret_type == VariableType::VOID);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value())->name == "print");
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value())->access_type == AccessType::PUBLIC);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value())->modifier == MethodType::NATIVE);
+    EXPECT_TRUE(static_cast<MethodNode*>(ast[0][3].value())->ret_type == VariableType::VOID);
 
-    EXPECT_TRUE(ast[0][3][0].value().get()->type() == NodeType::MET_PAR);
+    EXPECT_TRUE(ast[0][3][0].value()->type() == NodeType::MET_PAR);
     EXPECT_TRUE(ast[0][3][0].branches_num() == 0);
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][3][0].value().get())->name == "c");
-    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][3][0].value().get())->var_type == VariableType::LONG);
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][3][0].value())->name == "c");
+    EXPECT_TRUE(static_cast<MethodParameterNode*>(ast[0][3][0].value())->var_type == VariableType::LONG);
 
-    EXPECT_TRUE(ast[0][3][1].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][3][1].value()->type() == NodeType::SCOPE);
     EXPECT_TRUE(ast[0][3][1].branches_num() == 0);
 }
 
@@ -247,17 +247,17 @@ TEST(ASTMakerTest, Operators) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][1][2][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][1][2][0].value().get())->op_type == OperationType::RETURN);
+    EXPECT_TRUE(ast[0][1][2][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][1][2][0].value())->op_type == OperationType::RETURN);
 
-    EXPECT_TRUE(ast[0][1][2][0][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][1][2][0][0].value().get())->op_type == OperationType::ADD);
+    EXPECT_TRUE(ast[0][1][2][0][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][1][2][0][0].value())->op_type == OperationType::ADD);
 
-    EXPECT_TRUE(ast[0][1][2][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][1][2][0][0][0].value().get())->name == "left");
+    EXPECT_TRUE(ast[0][1][2][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][1][2][0][0][0].value())->name == "left");
 
-    EXPECT_TRUE(ast[0][1][2][0][0][1].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][1][2][0][0][1].value().get())->name == "right");
+    EXPECT_TRUE(ast[0][1][2][0][0][1].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][1][2][0][0][1].value())->name == "right");
 }
 
 TEST(ASTMakerTest, Function) // NOLINT
@@ -270,34 +270,34 @@ TEST(ASTMakerTest, Function) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][1][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0].value().get())->op_type == OperationType::ASSIGN);
+    EXPECT_TRUE(ast[0][0][1][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0].value())->op_type == OperationType::ASSIGN);
 
-    EXPECT_TRUE(ast[0][0][1][0][0].value().get()->type() == NodeType::VAR_DECL);
-    EXPECT_TRUE(static_cast<VariableDeclarationNode*>(ast[0][0][1][0][0].value().get())->var_type == VariableType::INT);
-    EXPECT_TRUE(static_cast<VariableDeclarationNode*>(ast[0][0][1][0][0].value().get())->name == "num");
+    EXPECT_TRUE(ast[0][0][1][0][0].value()->type() == NodeType::VAR_DECL);
+    EXPECT_TRUE(static_cast<VariableDeclarationNode*>(ast[0][0][1][0][0].value())->var_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<VariableDeclarationNode*>(ast[0][0][1][0][0].value())->name == "num");
 
-    EXPECT_TRUE(ast[0][0][1][0][1].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0][1].value().get())->op_type == OperationType::MUL);
+    EXPECT_TRUE(ast[0][0][1][0][1].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0][1].value())->op_type == OperationType::MUL);
 
-    EXPECT_TRUE(ast[0][0][1][0][1][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][0].value().get())->name == "a");
+    EXPECT_TRUE(ast[0][0][1][0][1][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][0].value())->name == "a");
 
-    EXPECT_TRUE(ast[0][0][1][0][1][1].value().get()->type() == NodeType::FUNCTION);
-    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][1][0][1][1].value().get())->name == "foo");
+    EXPECT_TRUE(ast[0][0][1][0][1][1].value()->type() == NodeType::FUNCTION);
+    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][1][0][1][1].value())->name == "foo");
 
-    EXPECT_TRUE(ast[0][0][1][0][1][1][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0][1][1][0].value().get())->op_type == OperationType::SUB);
+    EXPECT_TRUE(ast[0][0][1][0][1][1][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][1][0][1][1][0].value())->op_type == OperationType::SUB);
 
-    EXPECT_TRUE(ast[0][0][1][0][1][1][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][1][0][0].value().get())->name == "a");
+    EXPECT_TRUE(ast[0][0][1][0][1][1][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][1][0][0].value())->name == "a");
 
-    EXPECT_TRUE(ast[0][0][1][0][1][1][0][1].value().get()->type() == NodeType::NUMBER);
-    EXPECT_TRUE(static_cast<NumberNode*>(ast[0][0][1][0][1][1][0][1].value().get())->num_type == VariableType::INT);
-    EXPECT_TRUE(static_cast<NumberNode*>(ast[0][0][1][0][1][1][0][1].value().get())->number.i == 1);
+    EXPECT_TRUE(ast[0][0][1][0][1][1][0][1].value()->type() == NodeType::NUMBER);
+    EXPECT_TRUE(static_cast<NumberNode*>(ast[0][0][1][0][1][1][0][1].value())->num_type == VariableType::INT);
+    EXPECT_TRUE(static_cast<NumberNode*>(ast[0][0][1][0][1][1][0][1].value())->number.i == 1);
 
-    EXPECT_TRUE(ast[0][0][1][0][1][1][1].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][1][1].value().get())->name == "a");
+    EXPECT_TRUE(ast[0][0][1][0][1][1][1].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][1][0][1][1][1].value())->name == "a");
 }
 
 TEST(ASTMakerTest, Control) // NOLINT
@@ -312,16 +312,16 @@ TEST(ASTMakerTest, Control) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][0][0].value().get()->type() == NodeType::CONTROL);
-    EXPECT_TRUE(static_cast<ControlNode*>(ast[0][0][0][0].value().get())->control_type == ControlType::IF);
+    EXPECT_TRUE(ast[0][0][0][0].value()->type() == NodeType::CONTROL);
+    EXPECT_TRUE(static_cast<ControlNode*>(ast[0][0][0][0].value())->control_type == ControlType::IF);
 
-    EXPECT_TRUE(ast[0][0][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value().get())->name == "cond");
+    EXPECT_TRUE(ast[0][0][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value())->name == "cond");
 
-    EXPECT_TRUE(ast[0][0][0][0][1].value().get()->type() == NodeType::SCOPE);
+    EXPECT_TRUE(ast[0][0][0][0][1].value()->type() == NodeType::SCOPE);
 
-    EXPECT_TRUE(ast[0][0][0][0][1][0].value().get()->type() == NodeType::FUNCTION);
-    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][0][0][1][0].value().get())->name == "foo");
+    EXPECT_TRUE(ast[0][0][0][0][1][0].value()->type() == NodeType::FUNCTION);
+    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][0][0][1][0].value())->name == "foo");
 }
 
 TEST(ASTMakerTest, String) // NOLINT
@@ -334,14 +334,14 @@ TEST(ASTMakerTest, String) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][0][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value().get())->op_type == OperationType::ASSIGN);
+    EXPECT_TRUE(ast[0][0][0][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value())->op_type == OperationType::ASSIGN);
 
-    EXPECT_TRUE(ast[0][0][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value().get())->name == "str");
+    EXPECT_TRUE(ast[0][0][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value())->name == "str");
 
-    EXPECT_TRUE(ast[0][0][0][0][1].value().get()->type() == NodeType::STRING);
-    EXPECT_TRUE(static_cast<StringNode*>(ast[0][0][0][0][1].value().get())->value == "abcd");
+    EXPECT_TRUE(ast[0][0][0][0][1].value()->type() == NodeType::STRING);
+    EXPECT_TRUE(static_cast<StringNode*>(ast[0][0][0][0][1].value())->value == "abcd");
 }
 
 TEST(ASTMakerTest, Symbol) // NOLINT
@@ -354,14 +354,14 @@ TEST(ASTMakerTest, Symbol) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][0][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value().get())->op_type == OperationType::ASSIGN);
+    EXPECT_TRUE(ast[0][0][0][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value())->op_type == OperationType::ASSIGN);
 
-    EXPECT_TRUE(ast[0][0][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value().get())->name == "ch");
+    EXPECT_TRUE(ast[0][0][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value())->name == "ch");
 
-    EXPECT_TRUE(ast[0][0][0][0][1].value().get()->type() == NodeType::SYMBOL);
-    EXPECT_TRUE(static_cast<SymbolNode*>(ast[0][0][0][0][1].value().get())->value == 'a');
+    EXPECT_TRUE(ast[0][0][0][0][1].value()->type() == NodeType::SYMBOL);
+    EXPECT_TRUE(static_cast<SymbolNode*>(ast[0][0][0][0][1].value())->value == 'a');
 }
 
 TEST(ASTMakerTest, OperatorNew) // NOLINT
@@ -374,17 +374,17 @@ TEST(ASTMakerTest, OperatorNew) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][0][0].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value().get())->op_type == OperationType::ASSIGN);
+    EXPECT_TRUE(ast[0][0][0][0].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0].value())->op_type == OperationType::ASSIGN);
 
-    EXPECT_TRUE(ast[0][0][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value().get())->name == "str");
+    EXPECT_TRUE(ast[0][0][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value())->name == "str");
 
-    EXPECT_TRUE(ast[0][0][0][0][1].value().get()->type() == NodeType::OPERATION);
-    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0][1].value().get())->op_type == OperationType::NEW);
+    EXPECT_TRUE(ast[0][0][0][0][1].value()->type() == NodeType::OPERATION);
+    EXPECT_TRUE(static_cast<OperationNode*>(ast[0][0][0][0][1].value())->op_type == OperationType::NEW);
 
-    EXPECT_TRUE(ast[0][0][0][0][1][0].value().get()->type() == NodeType::TYPE);
-    EXPECT_TRUE(static_cast<TypeNode*>(ast[0][0][0][0][1][0].value().get())->str == "String");
+    EXPECT_TRUE(ast[0][0][0][0][1][0].value()->type() == NodeType::TYPE);
+    EXPECT_TRUE(static_cast<TypeNode*>(ast[0][0][0][0][1][0].value())->str == "String");
 }
 
 TEST(ASTMakerTest, DotWord) // NOLINT
@@ -397,11 +397,11 @@ TEST(ASTMakerTest, DotWord) // NOLINT
         "}\n"
     )
 
-    EXPECT_TRUE(ast[0][0][0][0].value().get()->type() == NodeType::FUNCTION);
-    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][0][0].value().get())->name == "Other.foo");
+    EXPECT_TRUE(ast[0][0][0][0].value()->type() == NodeType::FUNCTION);
+    EXPECT_TRUE(static_cast<FunctionNode*>(ast[0][0][0][0].value())->name == "Other.foo");
 
-    EXPECT_TRUE(ast[0][0][0][0][0].value().get()->type() == NodeType::VARIABLE);
-    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value().get())->name == "Other.var");
+    EXPECT_TRUE(ast[0][0][0][0][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(static_cast<VariableNode*>(ast[0][0][0][0][0].value())->name == "Other.var");
 }
 
 TEST(ASTMakerTest, ClassError) // NOLINT
@@ -442,6 +442,18 @@ TEST(ASTMakerTest, AccessError) // NOLINT
     EXPECT_TRUE(ast_maker.err());
 }
 
+TEST(ASTMakerTest, ErrorLine) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   a\n"
+        "}\n"
+    )
+
+    ASSERT_TRUE(ast_maker.err());
+    EXPECT_NE(ast_maker.getErrors()->front().find("| class Main {\n"), std::string::npos);
+}
+
 TEST(ASTMakerTest, FieldTypeError) // NOLINT
 {
     CONSTRUCT_FILE(
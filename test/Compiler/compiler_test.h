@@ -2,8 +2,10 @@
 
 #include <gtest/gtest.h> // NOLINT
 
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -41,4 +43,138 @@ TEST(CompilerTest, LoadNormFile) // NOLINT
     EXPECT_TRUE(comp.compile("file", ".txt") == Compiler::OK);
 }
 
+TEST(CompilerTest, MultipleClasses) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class First; class Second;"
+    )
+    Compiler comp;
+    EXPECT_TRUE(comp.compile("file", ".txt") == Compiler::OK);
+
+    for (const std::string name : {"First", "Second"})
+    {
+        std::ifstream ifile(name + ".txt");
+        std::string class_name;
+        std::getline(ifile, class_name, '\0');
+        EXPECT_EQ(class_name, name);
+    }
+}
+
+TEST(CompilerTest, BranchOutOfRange) // NOLINT
+{
+    std::string body;
+    for (size_t i = 0; i < 3000; i++)
+    {
+        body += "           i = i + 1;\n";
+    }
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int count(int n) {\n"
+        "       int i = 0;\n"
+        "       while (i < n) {\n" + body +
+        "       }\n"
+        "       return i;\n"
+        "   }\n"
+        "}\n"
+    )
+    Compiler comp;
+    std::vector<std::string> errors;
+    EXPECT_TRUE(comp.compile("file", ".txt", &errors) == Compiler::FILE_NOT_COMPILED);
+    ASSERT_TRUE(errors.size() == 1);
+    EXPECT_TRUE(errors[0].find("Main.count") != std::string::npos);
+}
+
+TEST(CompilerTest, Parallel) // NOLINT
+{
+    std::vector<Compiler::Unit> units;
+    for (size_t i = 0; i < 16; i++)
+    {
+        std::string name = "file" + std::to_string(i);
+        std::ofstream ofile(name);
+        ofile << ((i % 3 == 0) ? "class" : "class C" + std::to_string(i) + ";");
+        ofile.close();
+        units.emplace_back().input_name = name;
+    }
+    units.emplace_back().input_name = "!";
+
+    Compiler comp(4);
+    comp.compile(&units, ".txt");
+
+    for (size_t i = 0; i < 16; i++)
+    {
+        EXPECT_EQ(units[i].err, (i % 3 == 0) ? Compiler::FILE_NOT_COMPILED : Compiler::OK);
+        EXPECT_EQ(units[i].errors.empty(), i % 3 != 0);
+    }
+    EXPECT_EQ(units.back().err, Compiler::FILE_NOT_FOUND);
+}
+
+TEST(CompilerTest, Cache) // NOLINT
+{
+    std::filesystem::remove_all("cache");
+    CONSTRUCT_FILE(
+        "class Cached;"
+    )
+    CompileCache cache("cache");
+    Compiler comp(1, &cache);
+
+    EXPECT_TRUE(comp.compile("file", ".txt") == Compiler::OK);
+    EXPECT_EQ(cache.hits(), 0);
+    EXPECT_EQ(cache.misses(), 1);
+
+    std::filesystem::remove("Cached.txt");
+    EXPECT_TRUE(comp.compile("file", ".txt") == Compiler::OK);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_TRUE(std::filesystem::exists("Cached.txt"));
+
+    ofile.open("file");
+    ofile << "class Cached; class Other;";
+    ofile.close();
+    EXPECT_TRUE(comp.compile("file", ".txt") == Compiler::OK);
+    EXPECT_EQ(cache.misses(), 2);
+    EXPECT_TRUE(std::filesystem::exists("Other.txt"));
+}
+
+TEST(CompilerTest, TimeReport) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class First {\n"
+        "   public int a;\n"
+        "   private float b;\n"
+        "}\n"
+        "class Second;\n"
+    )
+    std::vector<Compiler::Unit> units(2);
+    units[0].input_name = "file";
+    units[1].input_name = "!";
+    Compiler comp(1, nullptr, nullptr, true);
+    comp.compile(&units, ".txt");
+
+    const TimeReport& report = units[0].report;
+    EXPECT_EQ(report.file_name, "file");
+    std::vector<std::string> phases;
+    for (const auto& phase : report.phases)
+    {
+        phases.push_back(phase.name);
+        EXPECT_TRUE(phase.ms >= 0);
+        EXPECT_TRUE(phase.peak_rss_kb > 0);
+    }
+    EXPECT_EQ(phases, std::vector<std::string>({"read", "parse", "inline", "optimize", "translate"}));
+    EXPECT_TRUE(report.parsed_nodes > 0);
+    EXPECT_TRUE(report.optimized_nodes >= report.parsed_nodes);
+    EXPECT_EQ(report.constant_pools, (std::vector<std::pair<std::string, size_t>>({{"Second", 0}, {"First", 2}})));
+    EXPECT_EQ(units[1].report.phases.size(), 1);
+
+    std::stringstream ss;
+    TimeReport::print(ss, {&units[0].report, &units[1].report});
+    EXPECT_TRUE(ss.str().find("Time report: file\n") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("Constant pool: First 2 entries\n") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("Time report: all files\n") != std::string::npos);
+
+    Compiler plain;
+    std::vector<Compiler::Unit> plain_units(1);
+    plain_units[0].input_name = "file";
+    plain.compile(&plain_units, ".txt");
+    EXPECT_TRUE(plain_units[0].report.phases.empty());
+}
+
 #undef CONSTRUCT_FILE
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "Compiler/Optimizer/Inliner.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "source_builder.h"
+
+#include <string>
+
+#include <gtest/gtest.h> // NOLINT
+
+#define CONSTRUCT_FILE(code)         \
+    PARSE_FILE(code)                 \
+    Inliner inliner(&ast);           \
+    inliner.inlineCalls(); //
+
+static bool hasCalls(ASTRef node)
+{
+    bool calls = (node.value()->type() == NodeType::FUNCTION);
+    for (size_t i = 0; i < node.branches_num(); i++)
+    {
+        calls = calls || hasCalls(node[i]);
+    }
+    return calls;
+}
+
+TEST(InlinerTest, SmallHelpers) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int counter;\n"
+        "   public static int sub(int a, int b) {\n"
+        "       return a - b;\n"
+        "   }\n"
+        "   public static int sq(int x) {\n"
+        "       return x * x;\n"
+        "   }\n"
+        "   public static int get() {\n"
+        "       return counter;\n"
+        "   }\n"
+        "   public static int f(int a, int b) {\n"
+        "       return sub(b, a) + sq(a) + Main.sub(sq(b), 2 * a) + get();\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_EQ(inliner.inlined(), 5);
+    EXPECT_FALSE(hasCalls(ast[0][4]));
+
+    LINK_FILE()
+
+    PkmValue res {.l = 0};
+    PkmMethod* mid = &cl.classes["Main"].methods["f"];
+    cl.classes["Main"].statics[0].i = 100;
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 3}, PkmValue {.i = 5}}, &res) == Interpreter::OK);
+    EXPECT_EQ(res.i, (5 - 3) + 3 * 3 + (5 * 5 - 2 * 3) + 100);
+}
+
+TEST(InlinerTest, KeepCalls) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int counter;\n"
+        "   public static int sq(int x) {\n"
+        "       return x * x;\n"
+        "   }\n"
+        "   public static int get() {\n"
+        "       return counter;\n"
+        "   }\n"
+        "   public static int fact(int a) {\n"
+        "       return fact(a - 1) * a;\n"
+        "   }\n"
+        "   public native int ext(int a) {}\n"
+        "   public static int f(int a) {\n"
+        "       int counter = sq(a + 1);\n"
+        "       sq(a);\n"
+        "       return counter + get() + fact(a) + ext(a);\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_EQ(inliner.inlined(), 0);
+}
+
+#undef CONSTRUCT_FILE
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "Compiler/Optimizer/LocalAllocator.h"
+#include "../VM/klass_builder.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // NOLINT
+
+static std::string bytecode(const std::vector<uint32_t>& code)
+{
+    return std::string(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(uint32_t));
+}
+
+TEST(LocalAllocatorTest, DisjointLifetimes) // NOLINT
+{
+    std::string code = bytecode({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 1),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 2),
+        instr(Opcode::ILOAD, 2),
+        instr(Opcode::IRETURN),
+    });
+
+    LocalAllocator allocator({VariableType::INT});
+    EXPECT_EQ(allocator.allocate(&code), 1);
+    EXPECT_EQ(code, bytecode({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    }));
+}
+
+TEST(LocalAllocatorTest, TypesDoNotMix) // NOLINT
+{
+    std::string code = bytecode({
+        instr(Opcode::LDC, 2),
+        instr(Opcode::FSTORE, 0),
+        instr(Opcode::FLOAD, 0),
+        instr(Opcode::POP),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 1),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IRETURN),
+    });
+
+    LocalAllocator allocator({});
+    EXPECT_EQ(allocator.allocate(&code), 2);
+}
+
+TEST(LocalAllocatorTest, LoopCarriedValue) // NOLINT
+{
+    std::string code = bytecode({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 1),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 2),
+        instr(Opcode::ILOAD, 2),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IADD),
+        instr(Opcode::ISTORE, 1),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IFNE, static_cast<uint16_t>(-28)),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IRETURN),
+    });
+
+    LocalAllocator allocator({VariableType::INT});
+    EXPECT_EQ(allocator.allocate(&code), 2);
+
+    Peephole::Code decoded = Peephole::decode(code);
+    EXPECT_EQ(decoded[1].arg16, 0);
+    EXPECT_EQ(decoded[3].arg16, 1);
+    EXPECT_EQ(decoded[7].arg16, 0);
+    EXPECT_EQ(decoded[9].target, 2);
+}
\ No newline at end of file
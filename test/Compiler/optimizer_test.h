@@ -0,0 +1,138 @@
+#include "Compiler/Optimizer/ASTOptimizer.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "source_builder.h"
+
+#include <string>
+
+#include <gtest/gtest.h> // NOLINT
+
+#define CONSTRUCT_FILE(code)         \
+    PARSE_FILE(code)                 \
+    ASTOptimizer optimizer(&ast);    \
+    optimizer.optimize(); //
+
+static ASTRef returnValue(const AST& ast)
+{
+    ASTRef method = ast[0][0];
+    ASTRef scope = method[method.branches_num() - 1];
+    return scope[0][0];
+}
+
+static bool isNumber(ASTRef node, int32_t number)
+{
+    return (node.value()->type() == NodeType::NUMBER) &&
+           (static_cast<NumberNode*>(node.value())->number.i == number);
+}
+
+static bool isOperation(ASTRef node, OperationType op_type)
+{
+    return (node.value()->type() == NodeType::OPERATION) &&
+           (static_cast<OperationNode*>(node.value())->op_type == op_type);
+}
+
+TEST(OptimizerTest, FoldConstants) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f() {\n"
+        "       return 2 * 3 + 4 - -1;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_TRUE(isNumber(returnValue(ast), 11));
+}
+
+TEST(OptimizerTest, FoldFloat) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static float f() {\n"
+        "       return 1.05 * 2.05;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    ASTRef ret = returnValue(ast);
+    ASSERT_TRUE(ret.value()->type() == NodeType::NUMBER);
+    EXPECT_TRUE(static_cast<NumberNode*>(ret.value())->num_type == VariableType::FLOAT);
+    EXPECT_FLOAT_EQ(static_cast<NumberNode*>(ret.value())->number.f, 1.05F * 2.05F);
+}
+
+TEST(OptimizerTest, KeepDivisionByZero) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f() {\n"
+        "       return 1 / 0;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_TRUE(isOperation(returnValue(ast), OperationType::DIV));
+}
+
+TEST(OptimizerTest, Identities) // NOLINT
+{
+    const char* exprs[] = {"a + 0", "0 + a", "a - 0", "a * 1", "1 * a", "a / 1"};
+    for (const char* expr : exprs)
+    {
+        CONSTRUCT_FILE(
+            std::string("class Main {\n"
+            "   public static int f(int a) {\n"
+            "       return ") + expr + ";\n"
+            "   }\n"
+            "}\n"
+        )
+
+        ASTRef ret = returnValue(ast);
+        EXPECT_TRUE(ret.value()->type() == NodeType::VARIABLE) << expr;
+    }
+}
+
+TEST(OptimizerTest, MultiplyByZero) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       return (a + 1) * 0;\n"
+        "   }\n"
+        "   public static int g(int a) {\n"
+        "       return f(a) * 0;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    ASTRef f_ret = ast[0][0][1][0][0];
+    ASTRef g_ret = ast[0][1][1][0][0];
+    EXPECT_TRUE(isNumber(f_ret, 0));
+    EXPECT_TRUE(isOperation(g_ret, OperationType::MUL));
+}
+
+TEST(OptimizerTest, StrengthReduction) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       return a * 8 + 4 * a;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    ASTRef ret = returnValue(ast);
+    ASSERT_TRUE(isOperation(ret, OperationType::ADD));
+    ASSERT_TRUE(isOperation(ret[0], OperationType::SHL));
+    EXPECT_TRUE(isNumber(ret[0][1], 3));
+    ASSERT_TRUE(isOperation(ret[1], OperationType::SHL));
+    EXPECT_TRUE(ret[1][0].value()->type() == NodeType::VARIABLE);
+    EXPECT_TRUE(isNumber(ret[1][1], 2));
+
+    LINK_FILE()
+
+    PkmValue res {.l = 0};
+    PkmMethod* mid = &cl.classes["Main"].methods["f"];
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 5}}, &res) == Interpreter::OK);
+    EXPECT_EQ(res.i, 60);
+}
+
+#undef CONSTRUCT_FILE
\ No newline at end of file
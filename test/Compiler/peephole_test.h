@@ -0,0 +1,119 @@
+#include "Compiler/Optimizer/Peephole.h"
+#include "../VM/klass_builder.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // NOLINT
+
+static std::string assemble(const std::vector<uint32_t>& code)
+{
+    return std::string(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(uint32_t));
+}
+
+static uint16_t offset(int16_t instructions)
+{
+    return static_cast<uint16_t>(instructions * 4);
+}
+
+TEST(PeepholeTest, StoreLoadReturn) // NOLINT
+{
+    std::string code = assemble({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+        instr(Opcode::RETURN),
+    });
+
+    Peephole::Stats stats;
+    Peephole peephole(&stats);
+    EXPECT_EQ(peephole.optimize(&code), 1);
+    EXPECT_EQ(code, assemble({instr(Opcode::LDC, 1), instr(Opcode::IRETURN)}));
+
+    EXPECT_EQ(stats.hits(Peephole::pattern("store_load")), 1);
+    EXPECT_EQ(stats.hits(Peephole::pattern("dup_store_return")), 1);
+    EXPECT_EQ(stats.hits(Peephole::pattern("unreachable")), 1);
+}
+
+TEST(PeepholeTest, RedundantLoads) // NOLINT
+{
+    std::string code = assemble({
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IMUL),
+        instr(Opcode::ILOAD, 2),
+        instr(Opcode::ISTORE, 2),
+        instr(Opcode::IRETURN),
+    });
+
+    Peephole peephole;
+    EXPECT_EQ(peephole.optimize(&code), 0);
+    EXPECT_EQ(code, assemble({
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::DUP),
+        instr(Opcode::IMUL),
+        instr(Opcode::IRETURN),
+    }));
+}
+
+TEST(PeepholeTest, Jumps) // NOLINT
+{
+    std::string code = assemble({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IFEQ, offset(3)),
+        instr(Opcode::GOTO, offset(1)),
+        instr(Opcode::GOTO, offset(1)),
+        instr(Opcode::GOTO, offset(2)),
+        instr(Opcode::NOP),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    });
+
+    Peephole peephole;
+    peephole.optimize(&code);
+    EXPECT_EQ(code, assemble({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::POP),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    }));
+}
+
+TEST(PeepholeTest, KeepBranchTargets) // NOLINT
+{
+    std::vector<uint32_t> loop = {
+        instr(Opcode::ISTORE, 0),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IFNE, offset(-1)),
+        instr(Opcode::GOTO, offset(0)),
+    };
+    std::string code = assemble(loop);
+
+    Peephole peephole;
+    peephole.optimize(&code);
+    EXPECT_EQ(code, assemble(loop));
+}
+
+TEST(PeepholeTest, SwitchTargets) // NOLINT
+{
+    std::string code = assemble({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::LOOKUPSWITCH, 1),
+        static_cast<uint32_t>(offset(6)), 7, static_cast<uint32_t>(offset(5)),
+        instr(Opcode::NOP),
+        instr(Opcode::GOTO, offset(1)),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IRETURN),
+    });
+
+    Peephole peephole;
+    peephole.optimize(&code);
+    EXPECT_EQ(code, assemble({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::LOOKUPSWITCH, 1),
+        static_cast<uint32_t>(offset(4)), 7, static_cast<uint32_t>(offset(4)),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IRETURN),
+    }));
+}
\ No newline at end of file
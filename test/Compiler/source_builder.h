@@ -0,0 +1,34 @@
+#ifndef TEST_COMPILER_SOURCE_BUILDER_H
+#define TEST_COMPILER_SOURCE_BUILDER_H
+
+#include "Compiler/AST/ASTMaker.h"
+#include "Compiler/Translator/Translator.h"
+#include "VM/ClassLinker.h"
+
+#include <fstream>
+#include <sstream>
+
+// Writes code to "file" and parses it into ast; the test runs its pass next.
+#define PARSE_FILE(code)             \
+    std::ofstream ofile("file");     \
+    ofile << (code);                 \
+    ofile.close();                   \
+    SourceFile source("file");       \
+    ASTMaker ast_maker(&source);     \
+    AST ast;                         \
+    ast_maker.make(&ast); //
+
+// Translates ast back into "file" and links it into cl.
+#define LINK_FILE()                  \
+    Translator trans(&ast);          \
+    ofile.open("file");              \
+    trans.translate(&ofile);         \
+    ofile.close();                   \
+    std::ifstream ifile("file");     \
+    std::stringstream ss;            \
+    ss << ifile.rdbuf();             \
+    Klasses kls = {ss.str()};        \
+    ClassLinker cl;                  \
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK); //
+
+#endif // TEST_COMPILER_SOURCE_BUILDER_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Compiler/Translator/Translator.h"
 #include "Opcodes.h"
 #include "VM/ClassLinker.h"
+#include "VM/Interpreter/Interpreter.h"
 
 #include <fstream>
 #include <iostream>
@@ -12,16 +13,15 @@
     std::ofstream ofile("file"); \
     ofile << (code);             \
     ofile.close();               \
-    std::ifstream ifile("file"); \
-    ASTMaker ast_maker(&ifile);  \
+    SourceFile source("file");   \
+    ASTMaker ast_maker(&source); \
     AST ast;                     \
     ast_maker.make(&ast);        \
-    ifile.close();               \
     Translator trans(&ast);      \
     ofile.open("file");          \
     trans.translate(&ofile);     \
     ofile.close();               \
-    ifile.open("file");          \
+    std::ifstream ifile("file"); \
     std::stringstream ss;        \
     ss << ifile.rdbuf();         \
     Klasses kls = {ss.str()};    \
@@ -138,6 +138,7 @@ TEST(TranslatorTest, Function) // NOLINT
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].ret_type == VariableType::INT);
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].name == 0);
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].locals_num == 1);
+    EXPECT_TRUE(cl.classes["Main"].methods["fact"].max_stack == 3);
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].offset == 0);
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].met_params.size() == 1);
     EXPECT_TRUE(cl.classes["Main"].methods["fact"].met_params[0] == VariableType::INT);
@@ -171,4 +172,317 @@ TEST(TranslatorTest, Function) // NOLINT
     EXPECT_TRUE(*reinterpret_cast<uint32_t*>(&cl.classes["Main"].bytecode[pos]) == instr);
 }
 
+TEST(TranslatorTest, StaticFields) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int counter;\n"
+        "   public static int inc() {\n"
+        "       counter = counter + 1;\n"
+        "       return counter;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_TRUE(cl.classes["Main"].fields.contains("counter"));
+    EXPECT_TRUE(cl.classes["Main"].fields["counter"].modifier == FieldType::STATIC);
+    EXPECT_TRUE(cl.classes["Main"].fields["counter"].var_type == VariableType::INT);
+    EXPECT_TRUE(cl.classes["Main"].statics.size() == 1);
+    EXPECT_TRUE(cl.classes["Main"].static_refs.size() == 1);
+    EXPECT_TRUE(cl.classes["Main"].static_refs[0] == &cl.classes["Main"].statics[0]);
+
+    size_t pos = 4;
+    uint32_t instr = static_cast<uint8_t>(Opcode::GETSTATIC_QUICK);
+    EXPECT_TRUE(*reinterpret_cast<uint32_t*>(&cl.classes["Main"].bytecode[pos]) == instr);
+    pos += 8;
+
+    instr = static_cast<uint8_t>(Opcode::PUTSTATIC_QUICK);
+    EXPECT_TRUE(*reinterpret_cast<uint32_t*>(&cl.classes["Main"].bytecode[pos]) == instr);
+
+    PkmValue res {.l = 0};
+    PkmMethod* mid = &cl.classes["Main"].methods["inc"];
+    EXPECT_TRUE(Interpreter::execute(mid, {}, &res) == Interpreter::OK);
+    EXPECT_TRUE(Interpreter::execute(mid, {}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 2);
+    EXPECT_TRUE(cl.classes["Main"].statics[0].i == 2);
+}
+
+
+TEST(TranslatorTest, WhileLoop) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int sum(int n) {\n"
+        "       int s = 0;\n"
+        "       int i = 0;\n"
+        "       while (i < n) {\n"
+        "           s = s + i;\n"
+        "           i = i + 1;\n"
+        "       }\n"
+        "       return s;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    PkmMethod* mid = &cl.classes["Main"].methods["sum"];
+    std::string bytecode = cl.classes["Main"].bytecode;
+    size_t branches = 0;
+    for (size_t pos = 0; pos < bytecode.size(); pos += 4)
+    {
+        EXPECT_TRUE(static_cast<Opcode>(bytecode[pos]) != Opcode::ICMP);
+        branches += (static_cast<Opcode>(bytecode[pos]) == Opcode::IF_ICMPLT) ? 1 : 0;
+    }
+    EXPECT_TRUE(branches == 1);
+
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 10}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 45);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 0}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 0);
+}
+
+TEST(TranslatorTest, IfElifElse) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int sign(int a) {\n"
+        "       int r = 0;\n"
+        "       if (a < 0) {\n"
+        "           r = 0 - 1;\n"
+        "       }\n"
+        "       elif (a == 0) {\n"
+        "           r = 0;\n"
+        "       }\n"
+        "       else {\n"
+        "           r = 1;\n"
+        "       }\n"
+        "       return r;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    PkmMethod* mid = &cl.classes["Main"].methods["sign"];
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = -7}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == -1);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 0}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 0);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 3}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 1);
+}
+
+TEST(TranslatorTest, ShortCircuit) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int inside(int a, int lo, int hi) {\n"
+        "       if ((a >= lo) && (a <= hi)) {\n"
+        "           return 1;\n"
+        "       }\n"
+        "       return 0;\n"
+        "   }\n"
+        "   public static int outside(int a, int lo, int hi) {\n"
+        "       return (a < lo) || (a > hi);\n"
+        "   }\n"
+        "}\n"
+    )
+
+    PkmMethod* inside = &cl.classes["Main"].methods["inside"];
+    PkmMethod* outside = &cl.classes["Main"].methods["outside"];
+    PkmValue res {.l = 0};
+    for (int32_t a = -1; a <= 3; a++)
+    {
+        bool in = (a >= 0) && (a <= 2);
+        std::vector<PkmValue> args = {PkmValue {.i = a}, PkmValue {.i = 0}, PkmValue {.i = 2}};
+        EXPECT_TRUE(Interpreter::execute(inside, args, &res) == Interpreter::OK);
+        EXPECT_TRUE(res.i == (in ? 1 : 0));
+        EXPECT_TRUE(Interpreter::execute(outside, args, &res) == Interpreter::OK);
+        EXPECT_TRUE(res.i == (in ? 0 : 1));
+    }
+}
+
+static size_t countOpcode(const std::string& bytecode, Opcode op)
+{
+    size_t num = 0;
+    for (size_t pos = 0; pos < bytecode.size(); pos += instructionSize(&bytecode[pos]))
+    {
+        num += (static_cast<Opcode>(bytecode[pos]) == op) ? 1 : 0;
+    }
+    return num;
+}
+
+TEST(TranslatorTest, DenseSwitch) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       int r = 0;\n"
+        "       if (a == 1) {\n"
+        "           r = 10;\n"
+        "       }\n"
+        "       elif (a == 2) {\n"
+        "           r = 20;\n"
+        "       }\n"
+        "       elif (4 == a) {\n"
+        "           r = 40;\n"
+        "       }\n"
+        "       elif (a == 3) {\n"
+        "           r = 30;\n"
+        "       }\n"
+        "       return r;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_TRUE(countOpcode(cl.classes["Main"].bytecode, Opcode::TABLESWITCH) == 1);
+    EXPECT_TRUE(countOpcode(cl.classes["Main"].bytecode, Opcode::IF_ICMPNE) == 0);
+
+    PkmMethod* mid = &cl.classes["Main"].methods["f"];
+    PkmValue res {.l = 0};
+    for (int32_t a = -1; a <= 6; a++)
+    {
+        EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = a}}, &res) == Interpreter::OK);
+        EXPECT_TRUE(res.i == (((a >= 1) && (a <= 4)) ? a * 10 : 0));
+    }
+}
+
+TEST(TranslatorTest, SparseSwitch) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       if (a == 1000) {\n"
+        "           return 1;\n"
+        "       }\n"
+        "       elif (a == 123456) {\n"
+        "           return 2;\n"
+        "       }\n"
+        "       elif (a == 5) {\n"
+        "           return 3;\n"
+        "       }\n"
+        "       else {\n"
+        "           return 4;\n"
+        "       }\n"
+        "       return 0;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    EXPECT_TRUE(countOpcode(cl.classes["Main"].bytecode, Opcode::LOOKUPSWITCH) == 1);
+
+    PkmMethod* mid = &cl.classes["Main"].methods["f"];
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 1000}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 1);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 123456}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 2);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 5}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 3);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 6}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 4);
+}
+
+TEST(TranslatorTest, ScopedLocals) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       int r = a;\n"
+        "       if (a < 10) {\n"
+        "           int t = a + 1;\n"
+        "           r = t * 2;\n"
+        "       }\n"
+        "       else {\n"
+        "           int u = a - 1;\n"
+        "           int r = u * 3;\n"
+        "           a = r;\n"
+        "       }\n"
+        "       return r + a;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    PkmMethod* mid = &cl.classes["Main"].methods["f"];
+    EXPECT_TRUE(mid->locals_num == 2);
+
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 4}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 14);
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 20}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 77);
+}
+
+TEST(TranslatorTest, FloatCall) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static float half(float a) {\n"
+        "       float h = a / 2.00;\n"
+        "       return h;\n"
+        "   }\n"
+        "   public static float quarter(float a) {\n"
+        "       return half(half(a));\n"
+        "   }\n"
+        "}\n"
+    )
+
+    PkmMethod* mid = &cl.classes["Main"].methods["quarter"];
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.f = 8.0F}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.f == 2.0F);
+}
+
+TEST(TranslatorTest, DiscardedCall) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int inc(int a) {\n"
+        "       return a + 1;\n"
+        "   }\n"
+        "   public static void skip(int a) {}\n"
+        "   public static int count(int n) {\n"
+        "       int i = 0;\n"
+        "       while (i < n) {\n"
+        "           inc(i);\n"
+        "           skip(i);\n"
+        "           i = i + 1;\n"
+        "       }\n"
+        "       return i;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    std::stringstream errors;
+    cl.printErrors(errors);
+    EXPECT_TRUE(errors.str().empty());
+
+    PkmMethod* mid = &cl.classes["Main"].methods["count"];
+    EXPECT_TRUE(mid->max_stack == 2);
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 5}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 5);
+}
+
+TEST(TranslatorTest, ElseWithoutIf) // NOLINT
+{
+    CONSTRUCT_FILE(
+        "class Main {\n"
+        "   public static int f(int a) {\n"
+        "       if (a > 0) {\n"
+        "           a = 1;\n"
+        "       }\n"
+        "       a = a + 1;\n"
+        "       else {\n"
+        "           a = 2;\n"
+        "       }\n"
+        "       return a;\n"
+        "   }\n"
+        "}\n"
+    )
+
+    ASSERT_TRUE(trans.err());
+    EXPECT_TRUE(trans.getErrors()->size() == 1);
+    EXPECT_TRUE((*trans.getErrors())[0] == "error: else/elif without if in Main.f");
+}
+
 #undef CONSTRUCT_FILE
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "VM/ClassLinker.h"
+#include "VM/Interpreter/AllocationProfiler.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "klass_builder.h"
+
+#include <sstream>
+
+#include <gtest/gtest.h> // NOLINT
+
+// int main(int n) { if (n == 0) return n; return main(n - 1) + n; }
+static const std::vector<uint32_t> ALLOC_CODE = {
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IFNE, 12),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IRETURN),
+    instr(Opcode::LDC, 1),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::ISUB),
+    instr(Opcode::INVOKESTATIC, 0),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IADD),
+    instr(Opcode::IRETURN),
+};
+
+// Frames of main take (0 locals + 3 stack slots) * 8 + sizeof(Frame) bytes.
+static const size_t ALLOC_FRAME_SIZE = 3 * sizeof(PkmValue) + sizeof(Frame);
+
+TEST(AllocationProfilerTest, EverySite) // NOLINT
+{
+    Klasses kls = {makeKlass(ALLOC_CODE, VariableType::INT, {VariableType::INT}, 1, 3)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    PkmMethod* mid = &cl.classes["Main"].methods["main"];
+
+    AllocationProfiler profiler(1);
+    ASSERT_TRUE(profiler.start() == AllocationProfiler::OK);
+    AllocationProfiler other;
+    EXPECT_TRUE(other.start() == AllocationProfiler::ALREADY_RUNNING);
+
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 100}}, &res) == Interpreter::OK);
+    profiler.stop();
+    EXPECT_FALSE(AllocationProfiler::active());
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 100}}, &res) == Interpreter::OK);
+
+    auto sites = profiler.sites();
+    ASSERT_TRUE(sites.size() == 1);
+    const auto& [site, stats] = *sites.begin();
+    EXPECT_TRUE(site.method == mid);
+    EXPECT_TRUE(site.offset == 28);
+    EXPECT_TRUE(stats.samples == 100);
+    EXPECT_NEAR(stats.count, 100, 1e-6); // NOLINT
+    EXPECT_NEAR(stats.bytes, 100 * ALLOC_FRAME_SIZE, 1e-6); // NOLINT
+
+    std::stringstream ss;
+    profiler.writeSummary(ss);
+    EXPECT_TRUE(ss.str().starts_with("allocation profile: 5600 bytes in 100 allocations, 100 samples"));
+    EXPECT_TRUE(ss.str().find("Main.main:28 (Frame)") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("by count:") != std::string::npos);
+}
+
+TEST(AllocationProfilerTest, Unbiased) // NOLINT
+{
+    Klasses kls = {makeKlass(ALLOC_CODE, VariableType::INT, {VariableType::INT}, 1, 3)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    PkmMethod* mid = &cl.classes["Main"].methods["main"];
+
+    AllocationProfiler profiler(10 * ALLOC_FRAME_SIZE);
+    ASSERT_TRUE(profiler.start() == AllocationProfiler::OK);
+    PkmValue res {.l = 0};
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 1000}}, &res) == Interpreter::OK);
+    }
+    profiler.stop();
+
+    auto sites = profiler.sites();
+    ASSERT_TRUE(sites.size() == 1);
+    const auto& stats = sites.begin()->second;
+    EXPECT_TRUE((stats.samples > 9000) && (stats.samples < 11000));
+    EXPECT_NEAR(stats.count, 100000, 5000); // NOLINT
+}
\ No newline at end of file
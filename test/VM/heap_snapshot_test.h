@@ -0,0 +1,90 @@
+#include "VM/ClassLinker.h"
+#include "VM/Heap/HeapAnalyzer.h"
+#include "VM/Heap/HeapDumper.h"
+#include "VM/Heap/HeapSnapshot.h"
+#include "klass_builder.h"
+
+#include <filesystem>
+#include <sstream>
+
+#include <gtest/gtest.h> // NOLINT
+
+//  r1(A,10) -> a(B,20) -> c(A,5) -> d(B,7) -> missing
+//  r2(B,1)  -> b(B,30) -> c
+//  r1 -> b,  e(A,100) is unreachable
+TEST(HeapSnapshotTest, Dominators) // NOLINT
+{
+    HeapSnapshotWriter writer;
+    ASSERT_TRUE(writer.open("graph.heap") == HeapSnapshotWriter::OK);
+    uint32_t a_type = writer.type("A");
+    writer.node(1, a_type, 10, {2, 3});
+    writer.root(1);
+    uint32_t b_type = writer.type("B");
+    writer.node(2, b_type, 20, {4});
+    writer.node(3, b_type, 30, {4});
+    writer.node(4, a_type, 5, {5});
+    writer.node(5, b_type, 7, {999});
+    writer.node(6, a_type, 100, {1});
+    writer.node(7, b_type, 1, {3});
+    writer.root(7);
+    ASSERT_TRUE(writer.close() == HeapSnapshotWriter::OK);
+
+    HeapAnalyzer analyzer;
+    ASSERT_TRUE(analyzer.load("graph.heap") == HeapAnalyzer::OK);
+    analyzer.analyze();
+    EXPECT_TRUE(analyzer.nodes() == 7);
+    EXPECT_TRUE(analyzer.dominator(analyzer.index(2)) == analyzer.index(1));
+    EXPECT_TRUE(analyzer.dominator(analyzer.index(3)) == HeapAnalyzer::NONE);
+    EXPECT_TRUE(analyzer.dominator(analyzer.index(4)) == HeapAnalyzer::NONE);
+    EXPECT_TRUE(analyzer.dominator(analyzer.index(5)) == analyzer.index(4));
+    EXPECT_TRUE(analyzer.retained(analyzer.index(1)) == 30);
+    EXPECT_TRUE(analyzer.retained(analyzer.index(4)) == 12);
+    EXPECT_TRUE(analyzer.retained(analyzer.index(6)) == 0);
+
+    const auto& classes = analyzer.classes();
+    ASSERT_TRUE(classes.size() == 2);
+    EXPECT_TRUE((classes[0].name == "B") && (classes[0].count == 4));
+    EXPECT_TRUE((classes[0].shallow == 58) && (classes[0].retained == 58));
+    EXPECT_TRUE((classes[1].name == "A") && (classes[1].count == 2));
+    EXPECT_TRUE((classes[1].shallow == 15) && (classes[1].retained == 42));
+
+    std::stringstream ss;
+    analyzer.print(ss);
+    EXPECT_TRUE(ss.str().starts_with("heap: 7 nodes, 7 edges, 2 roots, 73 bytes reachable, 1 nodes unreachable"));
+
+    std::filesystem::resize_file("graph.heap", std::filesystem::file_size("graph.heap") - 1);
+    EXPECT_TRUE(analyzer.load("graph.heap") == HeapAnalyzer::WRONG_FORMAT);
+    EXPECT_TRUE(analyzer.load("missing.heap") == HeapAnalyzer::FILE_NOT_OPENED);
+    std::filesystem::remove("graph.heap");
+}
+
+TEST(HeapSnapshotTest, LinkedClasses) // NOLINT
+{
+    Klasses kls = {makeKlass({instr(Opcode::LDC, 1), instr(Opcode::IRETURN)}, VariableType::INT, {}, 0)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    ASSERT_TRUE(HeapDumper::dump(cl.classes, "classes.heap") == HeapSnapshotWriter::OK);
+
+    HeapAnalyzer analyzer;
+    ASSERT_TRUE(analyzer.load("classes.heap") == HeapAnalyzer::OK);
+    analyzer.analyze();
+    EXPECT_TRUE(analyzer.nodes() == 8);
+
+    const PkmClass& cls = cl.classes["Main"];
+    uint32_t class_node = analyzer.index(reinterpret_cast<uintptr_t>(&cls));
+    uint32_t method_node = analyzer.index(reinterpret_cast<uintptr_t>(&cls.methods.at("main")));
+    uint32_t name_node = analyzer.index(reinterpret_cast<uintptr_t>(cls.const_pool[0].get()));
+    EXPECT_TRUE(analyzer.dominator(class_node) == HeapAnalyzer::NONE);
+    EXPECT_TRUE(analyzer.dominator(method_node) == class_node);
+    EXPECT_TRUE(analyzer.dominator(name_node) == class_node);
+
+    const auto& classes = analyzer.classes();
+    EXPECT_TRUE(classes[0].name == "Class");
+    uint64_t total = 0;
+    for (const auto& stats : classes)
+    {
+        total += stats.shallow;
+    }
+    EXPECT_TRUE(classes[0].retained == total);
+    std::filesystem::remove("classes.heap");
+}
\ No newline at end of file
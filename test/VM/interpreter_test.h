@@ -0,0 +1,132 @@
+#include "VM/ClassLinker.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "klass_builder.h"
+
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h> // NOLINT
+
+#define RUN_KLASS(args, ...)                                  \
+    Klasses kls = {makeKlass(__VA_ARGS__)};                   \
+    ClassLinker cl;                                           \
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);             \
+    PkmMethod* mid = &cl.classes["Main"].methods["main"];     \
+    PkmValue res {.l = 0};                                    \
+    int err = Interpreter::execute(mid, args, &res); //
+
+// int main(int n) { if (n == 0) return n; return main(n - 1) + n; }
+static const std::vector<uint32_t> SUM_CODE = {
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IFNE, 12),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IRETURN),
+    instr(Opcode::LDC, 1),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::ISUB),
+    instr(Opcode::INVOKESTATIC, 0),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IADD),
+    instr(Opcode::IRETURN),
+};
+
+TEST(InterpreterTest, Arithmetic) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.i = 7}}), {
+        instr(Opcode::LDC, 1),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::ISHL),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::ISUB),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == Interpreter::OK);
+    EXPECT_EQ(res.i, 7 - (7 << 1));
+}
+
+TEST(InterpreterTest, RecursiveCalls) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.i = 10000}}), SUM_CODE, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == Interpreter::OK);
+    EXPECT_EQ(res.i, 50005000);
+}
+
+TEST(InterpreterTest, StackOverflow) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.i = 100000000}}), SUM_CODE, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == Interpreter::STACK_OVERFLOW);
+}
+
+TEST(InterpreterTest, LongArithmetic) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.i = 100000}}), {
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::I2L),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::I2L),
+        instr(Opcode::LMUL),
+        instr(Opcode::LRETURN),
+    }, VariableType::LONG, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == Interpreter::OK);
+    EXPECT_EQ(res.l, 10000000000);
+}
+
+TEST(InterpreterTest, FloatCompare) // NOLINT
+{
+    std::vector<PkmValue> nan = {{.f = std::numeric_limits<float>::quiet_NaN()}};
+    {
+        RUN_KLASS(nan, {
+            instr(Opcode::FLOAD, 0),
+            instr(Opcode::FLOAD, 0),
+            instr(Opcode::FCMPL),
+            instr(Opcode::IRETURN),
+        }, VariableType::INT, {VariableType::FLOAT}, 1)
+
+        EXPECT_TRUE(err == Interpreter::OK);
+        EXPECT_EQ(res.i, -1);
+    }
+    {
+        RUN_KLASS(nan, {
+            instr(Opcode::FLOAD, 0),
+            instr(Opcode::FLOAD, 0),
+            instr(Opcode::FCMPG),
+            instr(Opcode::IRETURN),
+        }, VariableType::INT, {VariableType::FLOAT}, 1)
+
+        EXPECT_TRUE(err == Interpreter::OK);
+        EXPECT_EQ(res.i, 1);
+    }
+}
+
+TEST(InterpreterTest, Conversions) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.d = 1e20}}), {
+        instr(Opcode::DLOAD, 0),
+        instr(Opcode::D2I),
+        instr(Opcode::I2F),
+        instr(Opcode::LDC, 2),
+        instr(Opcode::FADD),
+        instr(Opcode::FRETURN),
+    }, VariableType::FLOAT, {VariableType::DOUBLE}, 1)
+
+    EXPECT_TRUE(err == Interpreter::OK);
+    EXPECT_EQ(res.f, static_cast<float>(std::numeric_limits<int32_t>::max()) + 1.0F);
+}
+
+TEST(InterpreterTest, DivisionByZero) // NOLINT
+{
+    RUN_KLASS(std::vector<PkmValue>({{.i = 0}}), {
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IDIV),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == Interpreter::ARITHMETIC_ERROR);
+}
+
+#undef RUN_KLASS
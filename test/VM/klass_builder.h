@@ -0,0 +1,55 @@
+#ifndef TEST_VM_KLASS_BUILDER_H
+#define TEST_VM_KLASS_BUILDER_H
+
+#include "ConstantPool.h"
+#include "Opcodes.h"
+#include "PkmEnums.h"
+
+#include <string>
+#include <vector>
+
+static uint32_t instr(Opcode op, uint16_t arg = 0)
+{
+    return static_cast<uint8_t>(op) + (static_cast<uint32_t>(arg) << 0x10);
+}
+
+static std::string makeKlass(const std::vector<uint32_t>& code, VariableType ret_type,
+    const std::vector<VariableType>& params, uint16_t locals_num, uint16_t max_stack = 2)
+{
+    std::string klass("Main", 5);
+    auto put = [&klass](auto value) {
+        klass.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    put(static_cast<uint16_t>(3));
+    put(static_cast<uint8_t>(AbstractType::Type::STRING));
+    klass.append("main", 5);
+    put(static_cast<uint8_t>(AbstractType::Type::INTEGER));
+    put(static_cast<int32_t>(1));
+    put(static_cast<uint8_t>(AbstractType::Type::FLOAT));
+    put(static_cast<float>(1));
+
+    put(static_cast<uint8_t>(0));
+
+    put(static_cast<uint8_t>(1));
+    put(static_cast<uint8_t>(AccessType::PUBLIC));
+    put(static_cast<uint8_t>(MethodType::STATIC));
+    put(static_cast<uint8_t>(ret_type));
+    put(static_cast<uint16_t>(0));
+    put(static_cast<uint8_t>(params.size()));
+    for (auto param : params)
+    {
+        put(static_cast<uint8_t>(param));
+    }
+    put(static_cast<uint32_t>(0));
+    put(locals_num);
+    put(max_stack);
+
+    for (auto word : code)
+    {
+        put(word);
+    }
+    return klass;
+}
+
+#endif // TEST_VM_KLASS_BUILDER_H
\ No newline at end of file
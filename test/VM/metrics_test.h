@@ -0,0 +1,53 @@
+#include "VM/ClassLinker.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "VM/Metrics/Metrics.h"
+#include "klass_builder.h"
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h> // NOLINT
+
+TEST(MetricsTest, SharedCounters) // NOLINT
+{
+    std::string name = "/pkm-vm-test." + std::to_string(getpid());
+    Metrics metrics;
+    ASSERT_TRUE(metrics.open(name) == Metrics::OK);
+    EXPECT_TRUE(metrics.open(name) == Metrics::ALREADY_OPENED);
+
+    MetricsReader reader;
+    ASSERT_TRUE(reader.open(name) == Metrics::OK);
+    const Metrics::Segment* segment = reader.segment();
+    EXPECT_TRUE(segment->version == Metrics::VERSION);
+    EXPECT_TRUE(segment->pid == static_cast<uint32_t>(getpid()));
+
+    Klasses kls = {makeKlass({instr(Opcode::LDC, 1), instr(Opcode::ILOAD, 0), instr(Opcode::IADD),
+        instr(Opcode::IRETURN)}, VariableType::INT, {VariableType::INT}, 1)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    EXPECT_TRUE(segment->classes_linked == 1);
+    EXPECT_TRUE(segment->methods_linked == 1);
+
+    PkmValue result = {};
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(Interpreter::execute(&cl.classes["Main"].methods["main"], {{.i = 1}}, &result) ==
+                    Interpreter::OK);
+    }
+    EXPECT_TRUE(segment->instructions_executed == 12);
+    EXPECT_TRUE(segment->gc_count == 0);
+
+    std::stringstream ss;
+    reader.print(ss);
+    EXPECT_TRUE(ss.str().find("pkm_instructions_executed_total 12\n") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("pkm_gc_pause_microseconds_bucket{le=\"+Inf\"} 0\n") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("pkm_gc_pause_microseconds_sum 0\n") != std::string::npos);
+    EXPECT_TRUE(ss.str().find("pkm_gc_pause_microseconds_count 0\n") != std::string::npos);
+
+    metrics.close();
+    Interpreter::execute(&cl.classes["Main"].methods["main"], {{.i = 1}}, &result);
+    EXPECT_TRUE(segment->instructions_executed == 12);
+
+    MetricsReader closed;
+    EXPECT_TRUE(closed.open(name) == Metrics::SEGMENT_NOT_OPENED);
+}
\ No newline at end of file
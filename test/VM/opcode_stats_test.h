@@ -0,0 +1,54 @@
+#ifdef VM_OPCODE_STATS
+
+#include "VM/ClassLinker.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "VM/Interpreter/OpcodeStats.h"
+#include "klass_builder.h"
+
+#include <sstream>
+
+#include <gtest/gtest.h> // NOLINT
+
+// int main(int n) { if (n == 0) return n; return main(n - 1) + n; }
+static const std::vector<uint32_t> STATS_CODE = {
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IFNE, 12),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IRETURN),
+    instr(Opcode::LDC, 1),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::ISUB),
+    instr(Opcode::INVOKESTATIC, 0),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IADD),
+    instr(Opcode::IRETURN),
+};
+
+TEST(OpcodeStatsTest, Histogram) // NOLINT
+{
+    Klasses kls = {makeKlass(STATS_CODE, VariableType::INT, {VariableType::INT}, 1, 3)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    PkmMethod* mid = &cl.classes["Main"].methods["main"];
+
+    OpcodeStats* stats = OpcodeStats::local();
+    stats->reset();
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 10}}, &res) == Interpreter::OK);
+    EXPECT_TRUE(res.i == 55);
+
+    EXPECT_TRUE(stats->count(Opcode::INVOKESTATIC) == 10);
+    EXPECT_TRUE(stats->count(Opcode::IRETURN) == 11);
+    EXPECT_TRUE(stats->count(Opcode::ILOAD) == 32);
+    EXPECT_TRUE(stats->pairCount(Opcode::ILOAD, Opcode::IFNE) == 11);
+    EXPECT_TRUE(stats->pairCount(Opcode::INVOKESTATIC, Opcode::ILOAD) == 10);
+    EXPECT_TRUE(stats->pairCount(Opcode::IRETURN, Opcode::ILOAD) == 10);
+
+    std::stringstream ss;
+    stats->print(ss);
+    EXPECT_TRUE(ss.str().starts_with("Opcode"));
+    EXPECT_TRUE(ss.str().find("ILOAD -> IFNE") != std::string::npos);
+    stats->reset();
+}
+
+#endif // VM_OPCODE_STATS
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "VM/Perf/PerfMap.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include <gtest/gtest.h> // NOLINT
+
+TEST(PerfMapTest, MapAndDump) // NOLINT
+{
+    std::string code = "\x55\x48\x89\xE5\x5D\xC3\x90\x90";
+
+    std::string pid = std::to_string(getpid());
+    {
+        PerfMap perf;
+        ASSERT_TRUE(perf.open(true, ".") == PerfMap::OK);
+        EXPECT_TRUE(perf.is_open());
+        perf.addCode(code.data(), code.size(), "pkm::Main.main");
+    }
+
+    std::ifstream map("perf-" + pid + ".map");
+    std::string start;
+    std::string size;
+    std::string name;
+    map >> start >> size >> name;
+    EXPECT_TRUE(std::stoul(start, nullptr, 16) == reinterpret_cast<uintptr_t>(code.data()));
+    EXPECT_TRUE(std::stoul(size, nullptr, 16) == 8);
+    EXPECT_TRUE(name == "pkm::Main.main");
+
+    std::ifstream dump_file("jit-" + pid + ".dump", std::ios::binary);
+    std::stringstream ss;
+    ss << dump_file.rdbuf();
+    std::string dump = ss.str();
+
+    // Header, code load record with its name and code, close record.
+    ASSERT_TRUE(dump.size() == 40 + (16 + 40 + 15 + 8) + 16);
+    uint32_t magic = 0;
+    std::memcpy(&magic, dump.data(), sizeof(magic));
+    EXPECT_TRUE(magic == 0x4A695444);
+    uint32_t id = 1;
+    std::memcpy(&id, dump.data() + 40, sizeof(id));
+    EXPECT_TRUE(id == 0);
+    EXPECT_TRUE(dump.compare(40 + 16 + 40, 15, std::string("pkm::Main.main", 15)) == 0);
+    EXPECT_TRUE(dump.compare(40 + 16 + 40 + 15, 8, code) == 0);
+
+    std::filesystem::remove("perf-" + pid + ".map");
+    std::filesystem::remove("jit-" + pid + ".dump");
+}
\ No newline at end of file
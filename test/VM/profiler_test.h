@@ -0,0 +1,56 @@
+#include "VM/ClassLinker.h"
+#include "VM/Interpreter/Interpreter.h"
+#include "VM/Interpreter/Profiler.h"
+#include "klass_builder.h"
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h> // NOLINT
+
+// int main(int n) { while (n != 0) n = n - 1; return 1; }
+static const std::vector<uint32_t> SPIN_CODE = {
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::IFEQ, 24),
+    instr(Opcode::LDC, 1),
+    instr(Opcode::ILOAD, 0),
+    instr(Opcode::ISUB),
+    instr(Opcode::ISTORE, 0),
+    instr(Opcode::GOTO, static_cast<uint16_t>(-24)),
+    instr(Opcode::LDC, 1),
+    instr(Opcode::IRETURN),
+};
+
+TEST(ProfilerTest, FoldedStacks) // NOLINT
+{
+    Klasses kls = {makeKlass(SPIN_CODE, VariableType::INT, {VariableType::INT}, 1)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+    PkmMethod* mid = &cl.classes["Main"].methods["main"];
+
+    Profiler profiler(500);
+    ASSERT_TRUE(profiler.start() == Profiler::OK);
+    EXPECT_TRUE(Profiler::active());
+    Profiler other;
+    EXPECT_TRUE(other.start() == Profiler::ALREADY_RUNNING);
+
+    PkmValue res {.l = 0};
+    EXPECT_TRUE(Interpreter::execute(mid, {PkmValue {.i = 5000000}}, &res) == Interpreter::OK);
+    profiler.stop();
+    EXPECT_FALSE(Profiler::active());
+    EXPECT_TRUE(res.i == 1);
+    ASSERT_TRUE(profiler.samples() > 0);
+
+    std::stringstream folded;
+    profiler.writeFolded(folded);
+    std::string line;
+    size_t samples = 0;
+    while (std::getline(folded, line))
+    {
+        EXPECT_TRUE(line.starts_with("Main.main:"));
+        size_t offset = std::stoul(line.substr(10));
+        EXPECT_TRUE(offset < 28);
+        samples += std::stoul(line.substr(line.rfind(' ') + 1));
+    }
+    EXPECT_TRUE(samples == profiler.samples());
+}
\ No newline at end of file
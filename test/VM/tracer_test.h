@@ -0,0 +1,49 @@
+#include "VM/ClassLinker.h"
+#include "VM/Trace/Tracer.h"
+#include "klass_builder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h> // NOLINT
+
+TEST(TracerTest, ChromeTrace) // NOLINT
+{
+    Tracer::instant("test", "ignored");
+
+    Tracer tracer;
+    ASSERT_TRUE(tracer.start("trace.json") == Tracer::OK);
+    EXPECT_TRUE(Tracer::enabled());
+
+    Tracer other;
+    EXPECT_TRUE(other.start("other.json") == Tracer::ALREADY_RUNNING);
+
+    Klasses kls = {makeKlass({instr(Opcode::LDC, 1), instr(Opcode::IRETURN)}, VariableType::INT, {}, 0)};
+    ClassLinker cl;
+    ASSERT_TRUE(cl.link(kls) == ClassLinker::OK);
+
+    std::thread worker([] { Tracer::instant("test", "worker", "quote\"d"); });
+    worker.join();
+    tracer.stop();
+    EXPECT_FALSE(Tracer::enabled());
+    EXPECT_TRUE(tracer.written() == 4);
+    EXPECT_TRUE(tracer.dropped() == 0);
+
+    std::ifstream file("trace.json");
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string trace = ss.str();
+    EXPECT_TRUE(trace.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_TRUE(trace.ends_with("\n]}\n"));
+    EXPECT_TRUE(trace.find("\"name\":\"appendClass\",\"cat\":\"link\",\"ph\":\"X\"") != std::string::npos);
+    EXPECT_TRUE(trace.find("\"args\":{\"detail\":\"Main\"}") != std::string::npos);
+    EXPECT_TRUE(trace.find("\"name\":\"verify\"") != std::string::npos);
+    EXPECT_TRUE(trace.find("\"ph\":\"i\"") != std::string::npos);
+    EXPECT_TRUE(trace.find("quote\\\"d") != std::string::npos);
+    EXPECT_TRUE(trace.find("ignored") == std::string::npos);
+
+    std::filesystem::remove("trace.json");
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "Compiler/AST/ASTMaker.h"
+#include "Compiler/Translator/Translator.h"
+#include "VM/ClassLinker.h"
+#include "klass_builder.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // NOLINT
+
+#define LINK_KLASS(...)                         \
+    Klasses kls = {makeKlass(__VA_ARGS__)};     \
+    ClassLinker cl;                             \
+    int err = cl.link(kls); //
+
+TEST(VerifierTest, ValidMethod) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IADD),
+        instr(Opcode::INVOKESTATIC, 0),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == ClassLinker::OK);
+}
+
+TEST(VerifierTest, StackUnderflow) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IADD),
+        instr(Opcode::RETURN),
+    }, VariableType::VOID, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, LocalOutOfRange) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::ILOAD, 1),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, LocalTypeMismatch) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 2),
+        instr(Opcode::FSTORE, 0),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {}, 1)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, ConstantOutOfRange) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 3),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, OperandTypeMismatch) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::LDC, 2),
+        instr(Opcode::IADD),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, ReturnTypeMismatch) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 2),
+        instr(Opcode::FRETURN),
+    }, VariableType::INT, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, StackOverflow) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::DUP),
+        instr(Opcode::IADD),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {}, 0, 1)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, BranchOutOfMethod) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::GOTO, 400),
+        instr(Opcode::RETURN),
+    }, VariableType::VOID, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, BackwardBranch) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IFNE, static_cast<uint16_t>(-4)),
+        instr(Opcode::RETURN),
+    }, VariableType::VOID, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == ClassLinker::OK);
+}
+
+TEST(VerifierTest, InconsistentStackAtMerge) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::LDC, 1),
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IFEQ, 8),
+        instr(Opcode::POP),
+        instr(Opcode::RETURN),
+    }, VariableType::VOID, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, BranchIntoSwitchTable) // NOLINT
+{
+    std::vector<uint32_t> code = {
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::TABLESWITCH, 2),
+        28, 0, 20, 28,
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IRETURN),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    };
+    {
+        LINK_KLASS(code, VariableType::INT, {VariableType::INT}, 1)
+        EXPECT_TRUE(err == ClassLinker::OK);
+    }
+
+    code[5] = 8;
+    LINK_KLASS(code, VariableType::INT, {VariableType::INT}, 1)
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, UnsortedLookupKeys) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::LOOKUPSWITCH, 2),
+        32, 5, 24, 1, 32,
+        instr(Opcode::LDC, 1),
+        instr(Opcode::IRETURN),
+        instr(Opcode::ILOAD, 0),
+        instr(Opcode::IRETURN),
+    }, VariableType::INT, {VariableType::INT}, 1)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, FallsOffEnd) // NOLINT
+{
+    LINK_KLASS({
+        instr(Opcode::NOP),
+    }, VariableType::VOID, {}, 0)
+
+    EXPECT_TRUE(err == ClassLinker::CLASS_NOT_VERIFIED);
+}
+
+TEST(VerifierTest, TranslatedClass) // NOLINT
+{
+    std::ofstream ofile("file");
+    ofile << "class Main {\n"
+             "   public static int fact(int a) {\n"
+             "       return fact(a - 1) * a;\n"
+             "   }\n"
+             "   public static void main() {}\n"
+             "}\n";
+    ofile.close();
+
+    SourceFile source("file");
+    ASTMaker ast_maker(&source);
+    AST ast;
+    ast_maker.make(&ast);
+
+    Translator trans(&ast);
+    ofile.open("file");
+    trans.translate(&ofile);
+    ofile.close();
+
+    std::ifstream ifile("file");
+    std::stringstream ss;
+    ss << ifile.rdbuf();
+    Klasses kls = {ss.str()};
+    ClassLinker cl;
+    EXPECT_TRUE(cl.link(kls) == ClassLinker::OK);
+}
+
+TEST(VerifierTest, CorruptedKlass) // NOLINT
+{
+    std::string klass = makeKlass({instr(Opcode::RETURN)}, VariableType::VOID, {}, 0);
+    Klasses kls = {klass.substr(0, 20)};
+    ClassLinker cl;
+    EXPECT_TRUE(cl.link(kls) == ClassLinker::KLASS_CORRUPTED);
+}
+
+#undef LINK_KLASS
\ No newline at end of file
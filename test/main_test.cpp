@@ -2,11 +2,24 @@
 
 #include "Compiler/astmaker_test.h"
 #include "Compiler/compiler_test.h"
+#include "Compiler/inliner_test.h"
+#include "Compiler/local_allocator_test.h"
+#include "Compiler/optimizer_test.h"
+#include "Compiler/peephole_test.h"
 #include "Compiler/translator_test.h"
 
+#include "VM/allocation_profiler_test.h"
 #include "VM/pkm_vm_test.h"
 #include "VM/pni_env_test.h"
+#include "VM/heap_snapshot_test.h"
+#include "VM/interpreter_test.h"
+#include "VM/metrics_test.h"
+#include "VM/opcode_stats_test.h"
+#include "VM/perf_map_test.h"
 #include "VM/pni_test.h"
+#include "VM/profiler_test.h"
+#include "VM/tracer_test.h"
+#include "VM/verifier_test.h"
 
 #include <gtest/gtest.h> // NOLINT
 